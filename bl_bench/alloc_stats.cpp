@@ -0,0 +1,282 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "alloc_stats.h"
+
+#include <atomic>
+#include <new>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+  #include <malloc.h>
+#endif
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+  // Sanitizers provide their own allocator - don't replace it.
+  #define BLBENCH_ALLOC_HOOKS_NONE
+#elif defined(__GLIBC__)
+  #define BLBENCH_ALLOC_HOOKS_MALLOC
+#else
+  #define BLBENCH_ALLOC_HOOKS_NEW
+#endif
+
+namespace blbench {
+
+static std::atomic<bool> alloc_enabled;
+static std::atomic<uint64_t> alloc_count;
+static std::atomic<uint64_t> alloc_bytes;
+
+static inline void alloc_record(size_t size) noexcept {
+  if (alloc_enabled.load(std::memory_order_relaxed)) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+}
+
+} // {blbench}
+
+// Allocation Hooks
+// ================
+
+#if defined(BLBENCH_ALLOC_HOOKS_MALLOC)
+
+// glibc allows replacing malloc() by defining it in the executable - the replacement is used by all shared
+// libraries as well, which means that allocations of Blend2D and other backends are counted. C++ allocations are
+// counted too as `operator new` (including aligned `operator new`) uses malloc() or aligned_alloc(). Memory is still
+// allocated by glibc's allocator.
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void* __libc_valloc(size_t size);
+void* __libc_pvalloc(size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) noexcept {
+  blbench::alloc_record(size);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+  blbench::alloc_record(count * size);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  blbench::alloc_record(size);
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+  blbench::alloc_record(size);
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+  blbench::alloc_record(size);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) noexcept {
+  // Unlike memalign(), posix_memalign() must reject alignments that are not a power of 2 multiple of sizeof(void*).
+  if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+    return EINVAL;
+
+  blbench::alloc_record(size);
+  void* p = __libc_memalign(alignment, size);
+  if (!p)
+    return ENOMEM;
+
+  *out = p;
+  return 0;
+}
+
+void* valloc(size_t size) noexcept {
+  blbench::alloc_record(size);
+  return __libc_valloc(size);
+}
+
+void* pvalloc(size_t size) noexcept {
+  blbench::alloc_record(size);
+  return __libc_pvalloc(size);
+}
+
+void free(void* ptr) noexcept {
+  __libc_free(ptr);
+}
+
+} // extern "C"
+
+#elif defined(BLBENCH_ALLOC_HOOKS_NEW)
+
+// malloc() cannot be replaced portably, so only C++ allocations done through global `operator new` are counted -
+// C allocations (malloc, posix_memalign, ...) of Blend2D and other libraries are missed, see `--alloc-stats` help.
+static void* alloc_new(size_t size) {
+  blbench::alloc_record(size);
+
+  void* p = malloc(size ? size : 1u);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+static void* alloc_new_nothrow(size_t size) noexcept {
+  blbench::alloc_record(size);
+  return malloc(size ? size : 1u);
+}
+
+void* operator new(size_t size) { return alloc_new(size); }
+void* operator new[](size_t size) { return alloc_new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return alloc_new_nothrow(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return alloc_new_nothrow(size); }
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+
+#if defined(__cpp_aligned_new)
+
+// Over-aligned C++ allocations (pixel buffers, SIMD data) - must be paired with the aligned delete below.
+static void* alloc_new_aligned_nothrow(size_t size, std::align_val_t alignment) noexcept {
+  blbench::alloc_record(size);
+
+  size_t a = size_t(alignment) < sizeof(void*) ? sizeof(void*) : size_t(alignment);
+#if defined(_WIN32)
+  return _aligned_malloc(size ? size : 1u, a);
+#else
+  void* p = nullptr;
+  return posix_memalign(&p, a, size ? size : 1u) == 0 ? p : nullptr;
+#endif
+}
+
+static void* alloc_new_aligned(size_t size, std::align_val_t alignment) {
+  void* p = alloc_new_aligned_nothrow(size, alignment);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+static void free_aligned(void* p) noexcept {
+#if defined(_WIN32)
+  _aligned_free(p);
+#else
+  free(p);
+#endif
+}
+
+void* operator new(size_t size, std::align_val_t a) { return alloc_new_aligned(size, a); }
+void* operator new[](size_t size, std::align_val_t a) { return alloc_new_aligned(size, a); }
+void* operator new(size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return alloc_new_aligned_nothrow(size, a); }
+void* operator new[](size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return alloc_new_aligned_nothrow(size, a); }
+
+void operator delete(void* p, std::align_val_t) noexcept { free_aligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { free_aligned(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { free_aligned(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { free_aligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { free_aligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { free_aligned(p); }
+
+#endif // __cpp_aligned_new
+
+#endif
+
+namespace blbench {
+
+// blbench::AllocTracker - Peak RSS
+// ================================
+
+#if defined(__linux__)
+
+// Reads a value of `key` (in kB) from /proc/self/status and returns it in bytes, or 0 if not available.
+static uint64_t read_proc_status_value(const char* key) {
+  FILE* f = fopen("/proc/self/status", "r");
+  if (!f)
+    return 0;
+
+  char line[256];
+  size_t key_size = strlen(key);
+  uint64_t value = 0;
+
+  while (fgets(line, sizeof(line), f)) {
+    if (strncmp(line, key, key_size) == 0 && line[key_size] == ':') {
+      value = strtoull(line + key_size + 1, nullptr, 10) * 1024u;
+      break;
+    }
+  }
+
+  fclose(f);
+  return value;
+}
+
+// Writing '5' to clear_refs resets the peak RSS (VmHWM) to the current RSS (Linux 4.0+).
+static bool reset_peak_rss() {
+  FILE* f = fopen("/proc/self/clear_refs", "w");
+  if (!f)
+    return false;
+
+  bool ok = fputs("5", f) >= 0;
+  ok &= fclose(f) == 0;
+  return ok;
+}
+
+static uint64_t read_current_rss() { return read_proc_status_value("VmRSS"); }
+static uint64_t read_peak_rss() { return read_proc_status_value("VmHWM"); }
+
+#else
+
+static bool reset_peak_rss() { return false; }
+static uint64_t read_current_rss() { return 0; }
+static uint64_t read_peak_rss() { return 0; }
+
+#endif
+
+// blbench::AllocTracker - API
+// ===========================
+
+bool AllocTracker::is_supported() {
+#if defined(BLBENCH_ALLOC_HOOKS_NONE)
+  return false;
+#else
+  return true;
+#endif
+}
+
+void AllocTracker::set_enabled(bool enabled) {
+  alloc_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void AllocTracker::start() {
+  // Files are read before the allocation counters are sampled, so their buffers are not counted.
+  _peak_reset = reset_peak_rss();
+  _start_rss = _peak_reset ? read_current_rss() : read_peak_rss();
+
+  _start_allocations = alloc_count.load(std::memory_order_relaxed);
+  _start_bytes = alloc_bytes.load(std::memory_order_relaxed);
+}
+
+void AllocTracker::stop(AllocCounters& out) {
+  out.reset();
+
+  out.allocations = alloc_count.load(std::memory_order_relaxed) - _start_allocations;
+  out.bytes = alloc_bytes.load(std::memory_order_relaxed) - _start_bytes;
+  out.has_allocations = is_supported();
+
+  uint64_t peak_rss = read_peak_rss();
+  if (peak_rss) {
+    out.peak_rss_delta = peak_rss > _start_rss ? peak_rss - _start_rss : uint64_t(0);
+    out.has_peak_rss = true;
+  }
+}
+
+} // {blbench}
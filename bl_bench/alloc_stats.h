@@ -0,0 +1,64 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_ALLOC_STATS_H
+#define BLBENCH_ALLOC_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace blbench {
+
+// blbench::AllocCounters
+// ======================
+
+//! Heap allocations and memory growth measured by `AllocTracker`.
+struct AllocCounters {
+  //! Number of heap allocations (all threads).
+  uint64_t allocations;
+  //! Number of bytes requested by heap allocations (all threads).
+  uint64_t bytes;
+  //! Growth of the peak resident set size of the process [bytes].
+  uint64_t peak_rss_delta;
+
+  //! True if `allocations` and `bytes` are valid (allocations can be counted by this build).
+  bool has_allocations;
+  //! True if `peak_rss_delta` is valid (the OS reports the peak resident set size).
+  bool has_peak_rss;
+
+  inline void reset() { *this = AllocCounters{}; }
+};
+
+// blbench::AllocTracker
+// =====================
+
+//! Counts heap allocations and measures peak RSS growth between `start()` and `stop()`.
+//!
+//! Allocations are counted by a shim that replaces `malloc()` family (glibc) or global `operator new` (elsewhere),
+//! thus allocations made by backend libraries are counted as well when they use the same allocator. Counting is
+//! process-wide (worker threads included) and costs a single relaxed load per allocation unless enabled.
+//!
+//! The peak RSS is read from `/proc/self/status` (Linux). The peak is reset by `start()` if the kernel allows it,
+//! otherwise only growth above the highest peak seen so far is reported.
+class AllocTracker {
+public:
+  uint64_t _start_allocations {};
+  uint64_t _start_bytes {};
+  uint64_t _start_rss {};
+  bool _peak_reset {};
+
+  //! Returns true if this build can count allocations.
+  static bool is_supported();
+
+  //! Enables or disables counting of allocations globally.
+  static void set_enabled(bool enabled);
+
+  void start();
+  void stop(AllocCounters& out);
+};
+
+} // {blbench}
+
+#endif // BLBENCH_ALLOC_STATS_H
@@ -5,15 +5,28 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 
+#if defined(_WIN32)
+  #include <process.h>
+#else
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <limits>
+#include <thread>
 #include <type_traits>
 #include <tuple>
+#include <vector>
 
 #include "app.h"
 #include "images_data.h"
 #include "backend_blend2d.h"
+#include "backend_null.h"
 
 #if defined(BLEND2D_APPS_ENABLE_AGG)
   #include "backend_agg.h"
@@ -62,6 +75,7 @@ static constexpr uint32_t supported_backends_mask =
 #if defined(BLEND2D_APPS_ENABLE_COREGRAPHICS)
   (1u << uint32_t(BackendKind::kCoreGraphics)) |
 #endif
+  (1u << uint32_t(BackendKind::kNull)) |
   (1u << uint32_t(BackendKind::kBlend2D));
 
 static const char* backend_kind_name_table[] = {
@@ -71,7 +85,8 @@ static const char* backend_kind_name_table[] = {
   "Qt",
   "Skia",
   "JUCE",
-  "CoreGraphics"
+  "CoreGraphics",
+  "Null"
 };
 
 static const char* test_kind_name_table[] = {
@@ -87,10 +102,36 @@ static const char* test_kind_name_table[] = {
   "FillPolyEOi20",
   "FillPolyNZi40",
   "FillPolyEOi40",
+  "FillPolyNZi1K",
+  "FillPolyNZi10K",
+  "FillPolyNZi100K",
+  "FillStar1K",
+  "FillStar10K",
+  "FillStar100K",
   "FillButterfly",
   "FillFish",
   "FillDragon",
   "FillWorld",
+  "FillRectABatch",
+  "FillRectUBatch",
+  "FillTextLabel",
+  "FillTextPara",
+  "FillGlyphRun",
+  "BlitScaleUp",
+  "BlitScaleDown",
+  "BlitScaleXY",
+  "BlitFrac",
+  "FillClipRect",
+  "FillClipNested",
+  "FillClipCall",
+  "FillGradStops2",
+  "FillGradStops8",
+  "FillGradStops32",
+  "FillGradStops256",
+  "FillGradReuse2",
+  "FillGradReuse8",
+  "FillGradReuse32",
+  "FillGradReuse256",
   "StrokeRectA",
   "StrokeRectU",
   "StrokeRectRot",
@@ -100,10 +141,15 @@ static const char* test_kind_name_table[] = {
   "StrokePoly10",
   "StrokePoly20",
   "StrokePoly40",
+  "StrokePoly1K",
+  "StrokePoly10K",
+  "StrokePoly100K",
   "StrokeButterfly",
   "StrokeFish",
   "StrokeDragon",
-  "StrokeWorld"
+  "StrokeWorld",
+  "StrokeRectABatch",
+  "StrokeRectUBatch"
 };
 
 static const char* comp_op_name_table[] = {
@@ -151,12 +197,54 @@ static const char* style_kind_name_table[] = {
   "Pattern_BI"
 };
 
+static const char* stroke_kind_name_table[] = {
+  "Hairline",
+  "W1",
+  "W2",
+  "W8",
+  "W32",
+  "W8RoundJoin",
+  "W8BevelJoin",
+  "W32RoundJoin",
+  "W2Dash",
+  "W8DashButt",
+  "W8DashRound",
+  "W8DashSquare"
+};
+
+static const char* shape_path_mode_name_table[] = {
+  "replay",
+  "rebuild",
+  "cached"
+};
+
+static const char* workload_mode_name_table[] = {
+  "inline",
+  "pregen"
+};
+
 static const int bench_shape_size_table[kBenchShapeSizeCount] = {
   8, 16, 32, 64, 128, 256
 };
 
+static const char* bench_shape_size_name_table[kBenchShapeSizeCount] = {
+  "8x8", "16x16", "32x32", "64x64", "128x128", "256x256"
+};
+
+// CPU features used by isolated Blend2D backends - only features that could actually make a difference.
+static const uint32_t isolated_cpu_feature_table[] = {
+  BL_RUNTIME_CPU_FEATURE_X86_SSE2,
+  BL_RUNTIME_CPU_FEATURE_X86_SSE3,
+  BL_RUNTIME_CPU_FEATURE_X86_SSSE3,
+  BL_RUNTIME_CPU_FEATURE_X86_SSE4_1,
+  BL_RUNTIME_CPU_FEATURE_X86_SSE4_2,
+  BL_RUNTIME_CPU_FEATURE_X86_AVX,
+  BL_RUNTIME_CPU_FEATURE_X86_AVX2,
+  BL_RUNTIME_CPU_FEATURE_X86_AVX512
+};
+
 const char bench_border_str[] = "+--------------------+-------------+---------------+----------+----------+----------+----------+----------+----------+\n";
-const char bench_header_str[] = "|%-20s"             "| CompOp      | Style         | 8x8      | 16x16    | 32x32    | 64x64    | 128x128  | 256x256  |\n";
+const char bench_header_str[] = "|%-20s"             "| CompOp      | Style         "   "| %-9s"   "| %-9s"   "| %-9s"   "| %-9s"   "| %-9s"   "| %-9s"   "|\n";
 const char bench_fata_fmt_str[]   = "|%-20s"             "| %-12s"     "| %-14s"       "| %-9s"   "| %-9s"   "| %-9s"   "| %-9s"   "| %-9s"   "| %-9s"   "|\n";
 
 static const char* get_os_string() {
@@ -209,6 +297,12 @@ static const char* get_cpu_arch_string() {
 #endif
 }
 
+static const BLFormat bench_format_table[] = {
+  BL_FORMAT_PRGB32,
+  BL_FORMAT_XRGB32,
+  BL_FORMAT_A8
+};
+
 static const char* get_format_string(BLFormat format) {
   switch (format) {
     case BL_FORMAT_PRGB32:
@@ -225,6 +319,30 @@ static const char* get_format_string(BLFormat format) {
   }
 }
 
+static unsigned get_process_id() {
+#if defined(_WIN32)
+  return unsigned(_getpid());
+#else
+  return unsigned(getpid());
+#endif
+}
+
+// Writes size and modification time of the running executable to `out`, which changes with every relink of bl_bench.
+static void get_executable_stamp(char* out, size_t size, const char* argv0) {
+#if defined(__linux__)
+  const char* path = "/proc/self/exe";
+  (void)argv0;
+#else
+  const char* path = argv0;
+#endif
+
+  struct stat st;
+  if (path && stat(path, &st) == 0)
+    snprintf(out, size, "%llu@%lld", (unsigned long long)st.st_size, (long long)st.st_mtime);
+  else
+    snprintf(out, size, "unknown");
+}
+
 static bool strieq(const char* a, const char* b) {
   size_t aLen = strlen(a);
   size_t bLen = strlen(b);
@@ -253,6 +371,101 @@ static uint32_t search_string_list(const char** listData, size_t listSize, const
   return 0xFFFFFFFFu;
 }
 
+static inline uint32_t ascii_lower(uint32_t c) {
+  return c >= 'A' && c <= 'Z' ? c + uint32_t('a' - 'A') : c;
+}
+
+// Case insensitive glob match of `str` against `pattern` of `pattern_size`, which supports '*' and '?' wildcards.
+static bool glob_match(const char* pattern, size_t pattern_size, const char* str) {
+  size_t p = 0;
+  size_t s = 0;
+  size_t star_p = SIZE_MAX;
+  size_t star_s = 0;
+
+  while (str[s]) {
+    if (p < pattern_size && (pattern[p] == '?' || ascii_lower((unsigned char)pattern[p]) == ascii_lower((unsigned char)str[s]))) {
+      p++;
+      s++;
+    }
+    else if (p < pattern_size && pattern[p] == '*') {
+      star_p = p++;
+      star_s = s;
+    }
+    else if (star_p != SIZE_MAX) {
+      p = star_p + 1;
+      s = ++star_s;
+    }
+    else {
+      return false;
+    }
+  }
+
+  while (p < pattern_size && pattern[p] == '*')
+    p++;
+  return p == pattern_size;
+}
+
+// Parses a comma separated list of glob patterns matched against `listData` names. Patterns prefixed with '-'
+// remove matching names, if the list starts with such pattern all names are selected first (e.g. '-Stroke*').
+static bool parse_glob_list(const char** listData, size_t listSize, const char* inputList, const char* option, uint64_t& mask_out) {
+  uint64_t mask = 0;
+  bool first = true;
+
+  const char* p = inputList;
+  for (;;) {
+    const char* end = strchr(p, ',');
+    size_t size = end ? size_t(end - p) : strlen(p);
+
+    if (size) {
+      bool remove = p[0] == '-';
+      const char* pattern = p + size_t(remove);
+      size_t pattern_size = size - size_t(remove);
+
+      if (first && remove)
+        mask = (listSize < 64 ? (uint64_t(1) << listSize) : uint64_t(0)) - 1u;
+      first = false;
+
+      uint64_t matched = 0;
+      for (size_t i = 0; i < listSize; i++) {
+        if (glob_match(pattern, pattern_size, listData[i]))
+          matched |= uint64_t(1) << i;
+      }
+
+      if (!matched) {
+        printf("ERROR: Invalid --%s=%s specified: '%.*s' doesn't match anything\n", option, inputList, int(pattern_size), pattern);
+        return false;
+      }
+
+      if (remove)
+        mask &= ~matched;
+      else
+        mask |= matched;
+    }
+
+    if (!end)
+      break;
+    p = end + 1;
+  }
+
+  if (!mask) {
+    printf("ERROR: Invalid --%s=%s specified: nothing selected\n", option, inputList);
+    return false;
+  }
+
+  mask_out = mask;
+  return true;
+}
+
+// Removes '@' part from the style name if not running a deep benchmark.
+static void format_style_name(char* out, uint32_t style_index, bool deep_bench) {
+  strcpy(out, style_kind_name_table[style_index]);
+
+  if (!deep_bench) {
+    char* x = strchr(out, '@');
+    if (x != nullptr) x[0] = '\0';
+  }
+}
+
 static void spacesToUnderscores(char* s) {
   while (*s) {
     if (*s == ' ')
@@ -318,6 +531,61 @@ static std::tuple<int, uint32_t> parse_list(const char** listData, size_t listSi
   return std::tuple<int, uint32_t>(listOp, parsedMask);
 }
 
+// Parses `<test>:<style>:<size>:<seconds>` soak specification, size can be specified as either `N` or `NxN`.
+static bool parse_soak_config(SoakConfig& out, const char* input) {
+  char buffer[256];
+  char* parts[4] {};
+
+  if (strlen(input) >= sizeof(buffer))
+    return false;
+  strcpy(buffer, input);
+
+  char* p = buffer;
+  for (uint32_t i = 0; i < 4; i++) {
+    parts[i] = p;
+    p = strchr(p, ':');
+
+    if (i < 3) {
+      if (!p)
+        return false;
+      *p++ = '\0';
+    }
+    else if (p) {
+      return false;
+    }
+  }
+
+  uint32_t test_index = search_string_list(test_kind_name_table, ARRAY_SIZE(test_kind_name_table), parts[0]);
+  uint32_t style_index = search_string_list(style_kind_name_table, ARRAY_SIZE(style_kind_name_table), parts[1]);
+
+  if (test_index == 0xFFFFFFFFu || style_index == 0xFFFFFFFFu)
+    return false;
+
+  char* size_end = nullptr;
+  unsigned long size = strtoul(parts[2], &size_end, 10);
+
+  if (size_end == parts[2] || size == 0 || size > 4096)
+    return false;
+
+  if (*size_end) {
+    char* h_end = nullptr;
+    if (*size_end != 'x' || strtoul(size_end + 1, &h_end, 10) != size || *h_end)
+      return false;
+  }
+
+  char* seconds_end = nullptr;
+  double seconds = strtod(parts[3], &seconds_end);
+
+  if (seconds_end == parts[3] || *seconds_end || !(seconds > 0.0))
+    return false;
+
+  out.test = TestKind(test_index);
+  out.style = StyleKind(style_index);
+  out.shape_size = uint32_t(size);
+  out.seconds = seconds;
+  return true;
+}
+
 struct DurationFormat {
   char data[64];
 
@@ -340,6 +608,197 @@ struct DurationFormat {
   }
 };
 
+static inline double duration_to_cpms(uint32_t quantity, uint64_t duration) {
+  return double(quantity) * double(1000) / double(duration ? duration : uint64_t(1));
+}
+
+static void add_stats_array(JSONBuilder& json, const char* key, const TestResult* results, uint32_t count, double SampleStats::*member) {
+  DurationFormat fmt;
+
+  json.add_key(key).open_array();
+  for (uint32_t i = 0; i < count; i++) {
+    fmt.format(results[i].stats.*member);
+    json.add_stringWithoutQuotes(fmt.data);
+  }
+  json.close_array();
+}
+
+static void add_latency(JSONBuilder& json, const TestResult* results, uint32_t count) {
+  json.add_key("latency").open_array();
+
+  for (uint32_t i = 0; i < count; i++) {
+    const LatencyHistogram& latency = results[i].latency;
+
+    json.open_object();
+    json.add_key("p50").add_uint(latency.value_at_percentile(50.0));
+    json.add_key("p90").add_uint(latency.value_at_percentile(90.0));
+    json.add_key("p99").add_uint(latency.value_at_percentile(99.0));
+    json.add_key("max").add_uint(latency.max());
+    json.close_object();
+  }
+
+  json.close_array();
+}
+
+// Allocations are normalized per render call like performance counters, peak RSS growth is reported per run.
+static void add_alloc_stats(JSONBuilder& json, const TestResult* results, uint32_t count) {
+  json.add_key("alloc").open_array();
+
+  for (uint32_t i = 0; i < count; i++) {
+    const TestResult& result = results[i];
+    const AllocCounters& allocs = result.allocs;
+    double quantity = double(result.quantity ? result.quantity : 1u);
+
+    json.open_object();
+    if (allocs.has_allocations) {
+      json.add_key("allocsPerCall").add_doublef("%0.3f", double(allocs.allocations) / quantity);
+      json.add_key("bytesPerCall").add_doublef("%0.1f", double(allocs.bytes) / quantity);
+    }
+    if (allocs.has_peak_rss) {
+      json.add_key("peakRssDelta").add_uint(allocs.peak_rss_delta);
+    }
+    json.close_object();
+  }
+
+  json.close_array();
+}
+
+// Returns the number of glyphs rendered by a single render call of a text test, zero if the test doesn't render text.
+static uint32_t glyphs_per_call(TestKind test) {
+  TextData text {};
+
+  switch (test) {
+    case TestKind::kFillTextLabel     : get_text_data(text, TextKind::kLabel); break;
+    case TestKind::kFillTextParagraph : get_text_data(text, TextKind::kParagraph); break;
+    case TestKind::kFillGlyphRun      : get_text_data(text, TextKind::kGlyphRun); break;
+
+    default:
+      break;
+  }
+
+  return text.glyph_count;
+}
+
+// Prints the glyph rate of a text test [millions of glyphs per second] as an additional row of the console table.
+static void print_glyph_rate(const double* cpms, uint32_t glyph_count, uint32_t count) {
+  char cells[kBenchShapeSizeCount][32] {};
+
+  for (uint32_t i = 0; i < count; i++) {
+    snprintf(cells[i], sizeof(cells[i]), "%0.2f", cpms[i] * double(glyph_count) / 1000.0);
+  }
+
+  printf(bench_fata_fmt_str, "  Mglyphs/s", "", "",
+    cells[0], cells[1], cells[2], cells[3], cells[4], cells[5]);
+}
+
+// Prints the vertex rate of a polygon test [millions of vertices per second] as an additional row of the console table.
+static void print_vertex_rate(const double* cpms, uint32_t vertex_count, uint32_t count) {
+  char cells[kBenchShapeSizeCount][32] {};
+
+  for (uint32_t i = 0; i < count; i++) {
+    snprintf(cells[i], sizeof(cells[i]), "%0.2f", cpms[i] * double(vertex_count) / 1000.0);
+  }
+
+  printf(bench_fata_fmt_str, "  Mvertices/s", "", "",
+    cells[0], cells[1], cells[2], cells[3], cells[4], cells[5]);
+}
+
+// Prints allocation statistics of a single test as additional rows of the console table.
+static void print_alloc_stats(const TestResult* results, uint32_t count) {
+  char cells[3][kBenchShapeSizeCount][32] {};
+
+  for (uint32_t i = 0; i < count; i++) {
+    const AllocCounters& allocs = results[i].allocs;
+    double quantity = double(results[i].quantity ? results[i].quantity : 1u);
+
+    if (allocs.has_allocations) {
+      snprintf(cells[0][i], sizeof(cells[0][i]), "%0.2f", double(allocs.allocations) / quantity);
+      snprintf(cells[1][i], sizeof(cells[1][i]), "%0.0f", double(allocs.bytes) / quantity);
+    }
+    if (allocs.has_peak_rss) {
+      snprintf(cells[2][i], sizeof(cells[2][i]), "%lluK", (unsigned long long)(allocs.peak_rss_delta / 1024u));
+    }
+  }
+
+  static const char* row_names[3] = { "  allocs/call", "  bytes/call", "  peak RSS delta" };
+  for (uint32_t row = 0; row < 3; row++) {
+    printf(bench_fata_fmt_str, row_names[row], "", "",
+      cells[row][0], cells[row][1], cells[row][2], cells[row][3], cells[row][4], cells[row][5]);
+  }
+}
+
+static void add_verify(JSONBuilder& json, const BenchApp& app, const TestResult* results, uint32_t count) {
+  json.add_key("verify").open_array();
+
+  for (uint32_t i = 0; i < count; i++) {
+    const TestResult& result = results[i];
+    const ImageDiff& diff = result.diff;
+
+    json.open_object();
+    if (result.verified) {
+      json.add_key("maxError").add_uint(diff.max_error);
+      json.add_key("diffPixels").add_uint(diff.diff_pixels);
+      if (diff.is_exact())
+        json.add_key("psnr").add_stringWithoutQuotes("null");
+      else
+        json.add_key("psnr").add_doublef("%0.2f", diff.psnr());
+      json.add_key("outlier").add_bool(app.is_verify_outlier(diff));
+    }
+    json.close_object();
+  }
+
+  json.close_array();
+}
+
+// Prints the result of verification of a single test as an additional row of the console table - outliers are
+// marked by '!'.
+static void print_verify(const BenchApp& app, const TestResult* results, uint32_t count) {
+  char cells[kBenchShapeSizeCount][32] {};
+
+  for (uint32_t i = 0; i < count; i++) {
+    const TestResult& result = results[i];
+
+    if (!result.verified)
+      snprintf(cells[i], sizeof(cells[i]), "n/a");
+    else if (result.diff.is_exact())
+      snprintf(cells[i], sizeof(cells[i]), "exact");
+    else
+      snprintf(cells[i], sizeof(cells[i]), "%0.1fdB%s", result.diff.psnr(), app.is_verify_outlier(result.diff) ? "!" : "");
+  }
+
+  printf(bench_fata_fmt_str, "  verify", "", "", cells[0], cells[1], cells[2], cells[3], cells[4], cells[5]);
+}
+
+// Counters are normalized per render call, so they don't depend on quantity. Only valid counters are emitted.
+static void add_perf_counters(JSONBuilder& json, const TestResult* results, uint32_t count) {
+  json.add_key("perf").open_array();
+
+  for (uint32_t i = 0; i < count; i++) {
+    const TestResult& result = results[i];
+    const PerfCounterValues& counters = result.counters;
+    double quantity = double(result.quantity ? result.quantity : 1u);
+
+    json.open_object();
+    for (uint32_t kind_index = 0; kind_index < kPerfCounterKindCount; kind_index++) {
+      PerfCounterKind kind = PerfCounterKind(kind_index);
+      if (counters.has(kind))
+        json.add_key(perf_counter_name(kind)).add_doublef("%0.1f", double(counters.get(kind)) / quantity);
+    }
+
+    if (counters.has(PerfCounterKind::kCycles)) {
+      double cycles = double(counters.get(PerfCounterKind::kCycles));
+      double shape_size = double(result.shape_size);
+
+      if (counters.has(PerfCounterKind::kInstructions) && cycles > 0.0)
+        json.add_key("ipc").add_doublef("%0.3f", double(counters.get(PerfCounterKind::kInstructions)) / cycles);
+      json.add_key("cyclesPerPixel").add_doublef("%0.4f", cycles / (quantity * shape_size * shape_size));
+    }
+    json.close_object();
+  }
+
+  json.close_array();
+}
+
 BenchApp::BenchApp(int argc, char** argv)
   : _cmd_line(argc, argv),
     _isolated(false),
@@ -375,31 +834,128 @@ void BenchApp::print_app_info() const {
 void BenchApp::print_options() const {
   const char no_yes[][4] = { "no", "yes" };
 
+  char canvas_string[128] {};
+  snprintf(canvas_string, sizeof(canvas_string), "%ux%u", _width, _height);
+  for (size_t i = 0; i < _canvases.size(); i++) {
+    size_t n = i ? strlen(canvas_string) : size_t(0);
+    snprintf(canvas_string + n, sizeof(canvas_string) - n, "%s%dx%d", i ? "," : "", _canvases[i].w, _canvases[i].h);
+  }
+
+  char format_string[128] {};
+  for (size_t i = 0; i < _formats.size(); i++) {
+    size_t n = strlen(format_string);
+    snprintf(format_string + n, sizeof(format_string) - n, "%s%s", i ? "," : "", get_format_string(_formats[i]));
+  }
+
+  char strokes_string[256] {};
+  for (size_t i = 0; i < _strokes.size(); i++) {
+    size_t n = strlen(strokes_string);
+    snprintf(strokes_string + n, sizeof(strokes_string) - n, "%s%s", i ? "," : "", stroke_kind_name_table[uint32_t(_strokes[i])]);
+  }
+
+  char shape_paths_string[64] {};
+  for (size_t i = 0; i < _shape_paths.size(); i++) {
+    size_t n = strlen(shape_paths_string);
+    snprintf(shape_paths_string + n, sizeof(shape_paths_string) - n, "%s%s", i ? "," : "", shape_path_mode_name_table[uint32_t(_shape_paths[i])]);
+  }
+
+  char sizes_string[128] {};
+  for (uint32_t i = 0; i < _size_count; i++) {
+    // Sizes are only known after the command line was parsed successfully.
+    uint32_t size = _shape_sizes[i] ? _shape_sizes[i] : uint32_t(bench_shape_size_table[i]);
+    size_t n = strlen(sizes_string);
+    snprintf(sizes_string + n, sizeof(sizes_string) - n, "%s%ux%u", i ? "," : "", size, size);
+  }
+
+  char threads_string[128] {};
+  for (size_t i = 0; i < _thread_counts.size(); i++) {
+    size_t n = strlen(threads_string);
+    snprintf(threads_string + n, sizeof(threads_string) - n, "%s%u", i ? "," : "", _thread_counts[i]);
+  }
+
   printf(
     "The following options are supported / used:\n"
     "  --width=N         [%u] Canvas width to use for rendering\n"
     "  --height=N        [%u] Canvas height to use for rendering\n"
+    "  --canvas=<list>   [%s] Canvas sizes to benchmark, overrides width/height (e.g. 256x256,1024x1024)\n"
+    "  --format=<list>   [%s] Pixel formats of the canvas (prgb32, xrgb32, a8)\n"
     "  --quantity=N      [%d] Render calls per test (0 = adjust depending on test duration)\n"
     "  --size-count=N    [%u] Number of size iterations (1=8x8 -> 6=8x8..256x256)\n"
+    "  --sizes=<list>    [%s] Sizes to benchmark, overrides --size-count (glob list, e.g. 8x8,64x64)\n"
+    "  --tests=<list>    [%s] Tests to benchmark (glob list, e.g. Fill*,-*World, '-x' to disable)\n"
+    "  --styles=<list>   [%s] Styles to benchmark, overrides --deep selection (glob list, e.g. Solid,Linear*)\n"
+    "  --stroke=<list>   [%s] Stroke options of polygon and shape stroke tests (glob list, e.g. W*,*Dash*)\n"
+    "  --shape-path=<list> [%s] Path modes of shape tests (replay=build once, rebuild=per call, cached=per position)\n"
     "  --comp-op=<list>  [%s] Benchmark a specific composition operator\n"
     "  --repeat=N        [%d] Number of repeats of each test to select the best time\n"
+    "  --max-repeat=N    [%u] Maximum number of repeats when --ci is used\n"
+    "  --target-duration=N [%u] Minimum duration of a run [us] when calibrating quantity (--quantity=0)\n"
+    "  --calibration-cache=<file> [%s] Reuse quantities saved in <file> until bl_bench is relinked (not on .so updates)\n"
+    "  --ci=N%%           [%g%%] Repeat until the median's 95%% confidence interval is narrower (0 = off)\n"
+    "  --time-budget=N   [%g] Spread N seconds across all tests, abort tests exceeding their share (0 = off)\n"
+    "  --soak=<t:s:n:sec> [%s] Render test:style:size for sec seconds on the first enabled backend (profiling)\n"
+    "  --soak-no-jit     [%s] Use Blend2D without JIT compiled pipelines in soak mode\n"
+    "  --perf-ctl=<fifo> [%s] Enable 'perf --control=fifo:<fifo>' only while soaking\n"
     "  --backends=<list> [%s] Backends to use (use 'a,b' to select few, '-xxx' to disable)\n"
+    "  --threads=<list>  [%s] Blend2D thread counts to benchmark (0=synchronous, 'auto'=all hardware threads)\n"
+    "  --farm=N          [%u] Render with N independent single-threaded Blend2D contexts on N threads (0=off)\n"
+    "  --baseline-backend=<name> [%s] Report throughput of all backends relative to this one (e.g. 'Blend2D ST')\n"
+    "  --workload=<mode> [%s] Generate random inputs 'inline' (timed) or 'pregen' (before timing)\n"
     "  --save-images     [%s] Save each generated image independently (use with --quantity)\n"
     "  --save-overview   [%s] Save generated images grouped by sizes  (use with --quantity)\n"
     "  --deep            [%s] More tests that use gradients and textures\n"
     "  --isolated        [%s] Use Blend2D isolated context (useful for development only)\n"
+    "  --perf-counters   [%s] Collect hardware performance counters of the benchmarking thread (Linux)\n"
+    "  --latency         [%s] Measure each render call and report latency percentiles [ns]\n"
+    "  --alloc-stats     [%s] Count heap allocations and peak RSS growth of each test (only C++ 'new' without glibc)\n"
+    "  --cold            [%s] Also measure up to 32 calls of each test with CPU caches evicted before each call\n"
+    "  --cold-buffer=N   [%u] Size of the buffer [MB] read to evict caches in --cold mode\n"
+    "  --verify          [%s] Compare rendered images with 'Blend2D ST' reference (error, PSNR, differing pixels)\n"
+    "  --verify-psnr=N   [%g] PSNR [dB] below which a verified test is reported as an outlier\n"
+    "  --subtract-overhead [%s] Subtract harness overhead measured by 'Null' backend from results\n"
+    "  --output=<file>   [%s] Append each test record to <file> as soon as it finishes (one JSON per line)\n"
+    "  --fsync           [%s] Synchronize --output file to the storage after each record\n"
     "\n",
     _width,
     _height,
+    canvas_string,
+    format_string,
     _quantity,
     _size_count,
+    sizes_string,
+    _test_mask == ~uint64_t(0) ? "all" : "...",
+    _style_mask == 0 ? "default" : "...",
+    strokes_string,
+    shape_paths_string,
     _comp_op == 0xFFFFFFFF ? "all" : comp_op_name_table[_comp_op],
     _repeat,
+    _max_repeat,
+    _target_duration,
+    _calibration_file ? _calibration_file : "none",
+    _ci,
+    _time_budget.seconds,
+    _soak.seconds > 0.0 ? "on" : "off",
+    no_yes[_soak_no_jit],
+    _perf_ctl_file ? _perf_ctl_file : "none",
     _backends == supported_backends_mask ? "all" : "...",
+    threads_string,
+    _farm,
+    _baseline_backend ? _baseline_backend : "none",
+    workload_mode_name_table[uint32_t(_workload_mode)],
     no_yes[_save_images],
     no_yes[_save_overview],
     no_yes[_deep_bench],
-    no_yes[_isolated]
+    no_yes[_isolated],
+    no_yes[_perf_counters],
+    no_yes[_latency],
+    no_yes[_alloc_stats],
+    no_yes[_cold],
+    unsigned((_cache_evictor.size() ? _cache_evictor.size() : CacheEvictor::default_size()) >> 20),
+    no_yes[_verify],
+    _verify_psnr,
+    no_yes[_subtract_overhead],
+    _output_file ? _output_file : "none",
+    no_yes[_fsync]
   );
 
   fflush(stdout);
@@ -434,14 +990,51 @@ bool BenchApp::parse_command_line() {
   _size_count = _cmd_line.value_as_uint("--size-count", _size_count);
   _quantity = _cmd_line.value_as_uint("--quantity", _quantity);
   _repeat = _cmd_line.value_as_uint("--repeat", _repeat);
+  _max_repeat = _cmd_line.value_as_uint("--max-repeat", _max_repeat);
+  _target_duration = _cmd_line.value_as_uint("--target-duration", _target_duration);
+  _calibration_file = _cmd_line.value_of("--calibration-cache", nullptr);
+  _farm = _cmd_line.value_as_uint("--farm", _farm);
+  _baseline_backend = _cmd_line.value_of("--baseline-backend", nullptr);
+
+  const char* ci_string = _cmd_line.value_of("--ci", nullptr);
+  if (ci_string)
+    _ci = strtod(ci_string, nullptr);
+
+  const char* verify_psnr_string = _cmd_line.value_of("--verify-psnr", nullptr);
+  if (verify_psnr_string)
+    _verify_psnr = strtod(verify_psnr_string, nullptr);
+
+  const char* time_budget_string = _cmd_line.value_of("--time-budget", nullptr);
+  if (time_budget_string)
+    _time_budget.seconds = strtod(time_budget_string, nullptr);
 
   _save_images = _cmd_line.has_arg("--save-images");
   _save_overview = _cmd_line.has_arg("--save-overview");
   _deep_bench = _cmd_line.has_arg("--deep");
   _isolated = _cmd_line.has_arg("--isolated");
+  _perf_counters = _cmd_line.has_arg("--perf-counters");
+  _latency = _cmd_line.has_arg("--latency");
+  _alloc_stats = _cmd_line.has_arg("--alloc-stats");
+  _verify = _cmd_line.has_arg("--verify");
+  _cold = _cmd_line.has_arg("--cold");
+  _soak_no_jit = _cmd_line.has_arg("--soak-no-jit");
+  _perf_ctl_file = _cmd_line.value_of("--perf-ctl", nullptr);
+  _subtract_overhead = _cmd_line.has_arg("--subtract-overhead");
+  _output_file = _cmd_line.value_of("--output", nullptr);
+  _fsync = _cmd_line.has_arg("--fsync");
 
   const char* comp_op_string = _cmd_line.value_of("--comp_op", nullptr);
   const char* backend_string = _cmd_line.value_of("--backend", nullptr);
+  const char* workload_string = _cmd_line.value_of("--workload", nullptr);
+  const char* threads_string = _cmd_line.value_of("--threads", nullptr);
+  const char* canvas_string = _cmd_line.value_of("--canvas", nullptr);
+  const char* format_string = _cmd_line.value_of("--format", nullptr);
+  const char* sizes_string = _cmd_line.value_of("--sizes", nullptr);
+  const char* tests_string = _cmd_line.value_of("--tests", nullptr);
+  const char* styles_string = _cmd_line.value_of("--styles", nullptr);
+  const char* stroke_string = _cmd_line.value_of("--stroke", nullptr);
+  const char* shape_path_string = _cmd_line.value_of("--shape-path", nullptr);
+  const char* soak_string = _cmd_line.value_of("--soak", nullptr);
 
   if (_width < 10|| _width > 4096) {
     printf("ERROR: Invalid --width=%u specified\n", _width);
@@ -468,6 +1061,97 @@ bool BenchApp::parse_command_line() {
     return false;
   }
 
+  if (_max_repeat < _repeat || _max_repeat > 10000) {
+    printf("ERROR: Invalid --max-repeat=%u specified (must be between --repeat and 10000)\n", _max_repeat);
+    return false;
+  }
+
+  if (_target_duration < 10 || _target_duration > 10000000) {
+    printf("ERROR: Invalid --target-duration=%u specified (must be between 10 and 10000000)\n", _target_duration);
+    return false;
+  }
+
+  if (_farm > 1024) {
+    printf("ERROR: Invalid --farm=%u specified\n", _farm);
+    return false;
+  }
+
+  if (!(_ci >= 0.0 && _ci <= 100.0)) {
+    printf("ERROR: Invalid --ci=%s specified\n", ci_string);
+    return false;
+  }
+
+  if (_cold) {
+    uint32_t cold_buffer_mb = _cmd_line.value_as_uint("--cold-buffer", uint32_t(CacheEvictor::default_size() >> 20));
+    if (cold_buffer_mb == 0 || cold_buffer_mb > 16384) {
+      printf("ERROR: Invalid --cold-buffer=%u specified\n", cold_buffer_mb);
+      return false;
+    }
+    _cache_evictor.init(size_t(cold_buffer_mb) << 20);
+  }
+
+  if (!(_verify_psnr >= 0.0)) {
+    printf("ERROR: Invalid --verify-psnr=%s specified\n", verify_psnr_string);
+    return false;
+  }
+
+  if (!(_time_budget.seconds >= 0.0)) {
+    printf("ERROR: Invalid --time-budget=%s specified\n", time_budget_string);
+    return false;
+  }
+
+  if (sizes_string) {
+    uint64_t size_mask;
+    if (!parse_glob_list(bench_shape_size_name_table, kBenchShapeSizeCount, sizes_string, "sizes", size_mask))
+      return false;
+
+    _size_count = 0;
+    for (uint32_t i = 0; i < kBenchShapeSizeCount; i++) {
+      if (size_mask & (uint64_t(1) << i))
+        _shape_sizes[_size_count++] = uint32_t(bench_shape_size_table[i]);
+    }
+  }
+  else {
+    for (uint32_t i = 0; i < _size_count; i++) {
+      _shape_sizes[i] = uint32_t(bench_shape_size_table[i]);
+    }
+  }
+
+  if (tests_string && !parse_glob_list(test_kind_name_table, kTestKindCount, tests_string, "tests", _test_mask)) {
+    return false;
+  }
+
+  if (styles_string) {
+    uint64_t style_mask;
+    if (!parse_glob_list(style_kind_name_table, kStyleKindCount, styles_string, "styles", style_mask))
+      return false;
+    _style_mask = uint32_t(style_mask);
+  }
+
+  if (stroke_string) {
+    uint64_t stroke_mask;
+    if (!parse_glob_list(stroke_kind_name_table, kStrokeKindCount, stroke_string, "stroke", stroke_mask))
+      return false;
+
+    _strokes.clear();
+    for (uint32_t i = 0; i < kStrokeKindCount; i++) {
+      if (stroke_mask & (uint64_t(1) << i))
+        _strokes.push_back(StrokeKind(i));
+    }
+  }
+
+  if (shape_path_string) {
+    uint64_t shape_path_mask;
+    if (!parse_glob_list(shape_path_mode_name_table, kShapePathModeCount, shape_path_string, "shape-path", shape_path_mask))
+      return false;
+
+    _shape_paths.clear();
+    for (uint32_t i = 0; i < kShapePathModeCount; i++) {
+      if (shape_path_mask & (uint64_t(1) << i))
+        _shape_paths.push_back(ShapePathMode(i));
+    }
+  }
+
   if (_save_images && !_quantity) {
     printf("ERROR: Missing --quantity argument; it must be provided when --save-images is used\n");
     return false;
@@ -486,6 +1170,100 @@ bool BenchApp::parse_command_line() {
     }
   }
 
+  _canvases.clear();
+
+  if (canvas_string) {
+    const char* p = canvas_string;
+    for (;;) {
+      unsigned w = 0;
+      unsigned h = 0;
+      int consumed = 0;
+
+      if (sscanf(p, "%ux%u%n", &w, &h, &consumed) != 2 || w < 10 || w > 4096 || h < 10 || h > 4096 ||
+          (p[consumed] != ',' && p[consumed] != '\0')) {
+        printf("ERROR: Invalid --canvas=%s specified\n", canvas_string);
+        return false;
+      }
+
+      _canvases.push_back(BLSizeI(int(w), int(h)));
+
+      if (p[consumed] == '\0')
+        break;
+      p += consumed + 1;
+    }
+  }
+  else {
+    _canvases.push_back(BLSizeI(int(_width), int(_height)));
+  }
+
+  if (format_string) {
+    _formats.clear();
+
+    const char* p = format_string;
+    for (;;) {
+      const char* end = strchr(p, ',');
+      size_t size = end ? size_t(end - p) : strlen(p);
+      size_t format_index = 0;
+
+      while (format_index < ARRAY_SIZE(bench_format_table)) {
+        const char* name = get_format_string(bench_format_table[format_index]);
+        if (strlen(name) == size && strncmp(name, p, size) == 0)
+          break;
+        format_index++;
+      }
+
+      if (format_index == ARRAY_SIZE(bench_format_table)) {
+        printf("ERROR: Invalid --format=%s specified\n", format_string);
+        return false;
+      }
+
+      _formats.push_back(bench_format_table[format_index]);
+
+      if (!end)
+        break;
+      p = end + 1;
+    }
+  }
+
+  if (threads_string) {
+    _thread_counts.clear();
+
+    const char* p = threads_string;
+    for (;;) {
+      const char* end = strchr(p, ',');
+      size_t size = end ? size_t(end - p) : strlen(p);
+
+      if (size == 4 && memcmp(p, "auto", 4) == 0) {
+        BLRuntimeSystemInfo si;
+        BLRuntime::query_system_info(&si);
+        _thread_counts.push_back(si.thread_count);
+      }
+      else {
+        char* number_end = nullptr;
+        unsigned long n = strtoul(p, &number_end, 10);
+
+        if (number_end != p + size || size == 0 || n > 1024) {
+          printf("ERROR: Invalid --threads=%s specified\n", threads_string);
+          return false;
+        }
+        _thread_counts.push_back(uint32_t(n));
+      }
+
+      if (!end)
+        break;
+      p = end + 1;
+    }
+  }
+
+  if (workload_string) {
+    uint32_t workload_mode = search_string_list(workload_mode_name_table, ARRAY_SIZE(workload_mode_name_table), workload_string);
+    if (workload_mode == 0xFFFFFFFF) {
+      printf("ERROR: Invalid --workload=%s specified\n", workload_string);
+      return false;
+    }
+    _workload_mode = WorkloadMode(workload_mode);
+  }
+
   if (backend_string && strcmp(backend_string, "all") != 0) {
     std::tuple<int, uint32_t> v = parse_list(backend_kind_name_table, kBackendKindCount, backend_string, "Invalid --backend list");
 
@@ -501,8 +1279,18 @@ bool BenchApp::parse_command_line() {
     }
   }
 
-  return true;
-}
+  if (soak_string && !parse_soak_config(_soak, soak_string)) {
+    printf("ERROR: Invalid --soak=%s specified (use test:style:size:seconds, e.g. FillRectU:Solid:64:10)\n", soak_string);
+    return false;
+  }
+
+  if (_subtract_overhead && !is_backend_enabled(BackendKind::kNull)) {
+    printf("ERROR: Null backend must be enabled when --subtract-overhead is used\n");
+    return false;
+  }
+
+  return true;
+}
 
 bool BenchApp::init() {
   if (_cmd_line.has_arg("--help")) {
@@ -515,6 +1303,26 @@ bool BenchApp::init() {
     exit(1);
   }
 
+  // Calibrate the latency timer now (used by --latency and --cold), thus it doesn't add to the first measured test.
+  if (_latency || _cold)
+    LatencyTimer::calibrate();
+
+  if (_latency) {
+
+    for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++) {
+      if ((_test_mask & (uint64_t(1) << test_index)) != 0 && is_amortized_test(TestKind(test_index))) {
+        printf("NOTE: Batch and gradient reuse tests are skipped by --latency, which renders a single item per call\n");
+        break;
+      }
+    }
+  }
+
+  if (_alloc_stats) {
+    if (!AllocTracker::is_supported())
+      printf("WARNING: Allocations cannot be counted by this build, only peak RSS will be reported\n");
+    AllocTracker::set_enabled(true);
+  }
+
   return read_image(_sprite_data[0], "#0", _resource_babelfish_png, sizeof(_resource_babelfish_png)) &&
          read_image(_sprite_data[1], "#1", _resource_ksplash_png  , sizeof(_resource_ksplash_png  )) &&
          read_image(_sprite_data[2], "#2", _resource_ktip_png     , sizeof(_resource_ktip_png     )) &&
@@ -563,6 +1371,9 @@ bool BenchApp::is_backend_enabled(BackendKind backend_kind) const {
 }
 
 bool BenchApp::is_style_enabled(StyleKind style) const {
+  if (_style_mask)
+    return (_style_mask & (1u << uint32_t(style))) != 0;
+
   if (_deep_bench)
     return true;
 
@@ -575,6 +1386,94 @@ bool BenchApp::is_style_enabled(StyleKind style) const {
          style == StyleKind::kPatternBI ;
 }
 
+bool BenchApp::is_verify_outlier(const ImageDiff& diff) const {
+  return !diff.is_exact() && diff.psnr() < _verify_psnr;
+}
+
+// Evicts caches before each render call of the cold pass, so rendering starts with cold caches - the surface and
+// sprites are flushed explicitly as they were just touched by the backend.
+void BenchApp::evict_caches(const Backend& backend) const {
+  _cache_evictor.evict();
+
+  CacheEvictor::flush_image(backend._surface);
+  for (const BLImage& sprite : backend._sprites)
+    CacheEvictor::flush_image(sprite);
+}
+
+bool BenchApp::is_test_enabled(TestKind test, StrokeKind stroke, ShapePathMode shape_path) const {
+  return (_test_mask & (uint64_t(1) << uint32_t(test))) != 0 &&
+         is_stroke_applicable(test, stroke) &&
+         is_shape_path_applicable(test, shape_path) &&
+         !(_latency && is_amortized_test(test));
+}
+
+uint32_t BenchApp::enabled_style_count() const {
+  uint32_t count = 0;
+  for (uint32_t style_index = 0; style_index < kStyleKindCount; style_index++)
+    count += uint32_t(is_style_enabled(StyleKind(style_index)));
+  return count;
+}
+
+uint32_t BenchApp::enabled_test_count(StrokeKind stroke, ShapePathMode shape_path) const {
+  uint32_t count = 0;
+  for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++)
+    count += uint32_t(is_test_enabled(TestKind(test_index), stroke, shape_path));
+  return count;
+}
+
+// Returns the number of tests (calls of `run_single_test()`) of all canvases and formats, used by --time-budget.
+// Tests that a backend doesn't support are counted as well, they are skipped in the budget when they are found.
+uint64_t BenchApp::count_tests() const {
+  uint64_t backend_runs = 0;
+
+  if (is_backend_enabled(BackendKind::kNull))
+    backend_runs++;
+
+  if (_isolated) {
+    BLRuntimeSystemInfo si;
+    BLRuntime::query_system_info(&si);
+
+    for (uint32_t feature : isolated_cpu_feature_table)
+      backend_runs += uint64_t((si.cpu_features & feature) == feature);
+  }
+  else {
+    for (uint32_t backend_index = 0; backend_index < kBackendKindCount; backend_index++) {
+      BackendKind backend_kind = BackendKind(backend_index);
+      if (backend_kind == BackendKind::kNull || !(supported_backends_mask & (1u << backend_index)) || !is_backend_enabled(backend_kind))
+        continue;
+
+      backend_runs += backend_kind == BackendKind::kBlend2D ? uint64_t(_thread_counts.size()) : uint64_t(1);
+    }
+  }
+
+  // Each test is run twice in --cold mode (warm and cold), except the reference test of the farm.
+  if (_cold)
+    backend_runs *= 2u;
+
+  if (_farm && is_backend_enabled(BackendKind::kBlend2D))
+    backend_runs++;
+
+  uint64_t comp_op_count = _comp_op != 0xFFFFFFFFu ? 1u : uint64_t(BL_COMP_OP_SRC_COPY - BL_COMP_OP_SRC_OVER + 1);
+  uint64_t tests_per_run = 0;
+
+  for (StrokeKind stroke : _strokes) {
+    for (ShapePathMode shape_path : _shape_paths)
+      tests_per_run += comp_op_count * enabled_style_count() * enabled_test_count(stroke, shape_path) * _size_count;
+  }
+
+  return uint64_t(_canvases.size()) * _formats.size() * backend_runs * tests_per_run;
+}
+
+void BenchApp::print_table_header(const char* name) const {
+  char sizes[kBenchShapeSizeCount][16] {};
+
+  for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+    snprintf(sizes[size_index], sizeof(sizes[size_index]), "%ux%u", _shape_sizes[size_index], _shape_sizes[size_index]);
+  }
+
+  printf(bench_header_str, name, sizes[0], sizes[1], sizes[2], sizes[3], sizes[4], sizes[5]);
+}
+
 void BenchApp::serialize_system_info(JSONBuilder& json) const {
   BLRuntimeSystemInfo system_info;
   BLRuntime::query_system_info(&system_info);
@@ -603,19 +1502,79 @@ void BenchApp::serialize_options(JSONBuilder& json, const BenchParams& params) c
   json.before_record().add_key("quantity").add_uint(params.quantity);
   json.before_record().add_key("sizes").open_array();
   for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
-    json.add_stringf("%dx%d", bench_shape_size_table[size_index], bench_shape_size_table[size_index]);
+    json.add_stringf("%ux%u", _shape_sizes[size_index], _shape_sizes[size_index]);
   }
   json.close_array();
   json.before_record().add_key("repeat").add_uint(_repeat);
+  json.before_record().add_key("maxRepeat").add_uint(_max_repeat);
+  json.before_record().add_key("targetDuration").add_uint(_target_duration);
+  json.before_record().add_key("ci").add_double(_ci);
+  json.before_record().add_key("timeBudget").add_double(_time_budget.seconds);
+  json.before_record().add_key("perfCounters").add_bool(_perf_counters);
+  json.before_record().add_key("latency").add_bool(_latency);
+  json.before_record().add_key("allocStats").add_bool(_alloc_stats);
+  json.before_record().add_key("cold").add_bool(_cold);
+  json.before_record().add_key("coldBufferSize").add_uint(_cache_evictor.size());
+  json.before_record().add_key("verify").add_bool(_verify);
+  json.before_record().add_key("verifyPsnr").add_double(_verify_psnr);
+  json.before_record().add_key("subtractOverhead").add_bool(_subtract_overhead);
+  json.before_record().add_key("canvases").open_array();
+  for (const BLSizeI& canvas : _canvases) {
+    json.add_stringf("%dx%d", canvas.w, canvas.h);
+  }
+  json.close_array();
+  json.before_record().add_key("formats").open_array();
+  for (BLFormat format : _formats) {
+    json.add_string(get_format_string(format));
+  }
+  json.close_array();
+  json.before_record().add_key("strokes").open_array();
+  for (StrokeKind stroke : _strokes) {
+    json.add_string(stroke_kind_name_table[uint32_t(stroke)]);
+  }
+  json.close_array();
+  json.before_record().add_key("shapePaths").open_array();
+  for (ShapePathMode shape_path : _shape_paths) {
+    json.add_string(shape_path_mode_name_table[uint32_t(shape_path)]);
+  }
+  json.close_array();
+  json.before_record().add_key("threads").open_array();
+  for (uint32_t thread_count : _thread_counts) {
+    json.add_uint(thread_count);
+  }
+  json.close_array();
+  json.before_record().add_key("farm").add_uint(_farm);
+  json.before_record().add_key("baselineBackend").add_string(_baseline_backend ? _baseline_backend : "");
+  json.before_record().add_key("workload").add_string(workload_mode_name_table[uint32_t(_workload_mode)]);
   json.close_object(true);
 }
 
 int BenchApp::run() {
+  if (_soak.seconds > 0.0) {
+    return run_soak();
+  }
+
   BenchParams params{};
-  params.screen_w = _width;
-  params.screen_h = _height;
-  params.format = BL_FORMAT_PRGB32;
-  params.stroke_width = 2.0;
+  params.screen_w = uint32_t(_canvases[0].w);
+  params.screen_h = uint32_t(_canvases[0].h);
+  params.format = _formats[0];
+  params.stroke = _strokes[0];
+  params.stroke_width = stroke_options_of(params.stroke).width;
+  params.shape_path = _shape_paths[0];
+
+  if (_output_file && !_record_writer.open(_output_file, _fsync)) {
+    printf("ERROR: Failed to open --output=%s\n", _output_file);
+    return 1;
+  }
+
+  if (_calibration_file) {
+    if (_calibration_cache.load(_calibration_file, calibration_fingerprint().c_str()))
+      printf("Calibration cache '%s' loaded (%zu quantities)\n\n", _calibration_file, _calibration_cache.size());
+  }
+
+  if (_time_budget.enabled()) {
+    _time_budget.start(count_tests());
+  }
 
   BLString json_content;
   JSONBuilder json(&json_content);
@@ -628,52 +1587,237 @@ int BenchApp::run() {
 
   json.before_record().add_key("runs").open_array();
 
+  for (const BLSizeI& canvas : _canvases) {
+    params.screen_w = uint32_t(canvas.w);
+    params.screen_h = uint32_t(canvas.h);
+
+    for (BLFormat format : _formats) {
+      params.format = format;
+
+      for (StrokeKind stroke : _strokes) {
+        params.stroke = stroke;
+        params.stroke_width = stroke_options_of(stroke).width;
+
+        for (ShapePathMode shape_path : _shape_paths) {
+          params.shape_path = shape_path;
+
+          if (_canvases.size() > 1 || _formats.size() > 1 || _strokes.size() > 1 || _shape_paths.size() > 1) {
+            printf("Canvas %ux%u (%s) Stroke %s Path %s\n\n",
+              params.screen_w,
+              params.screen_h,
+              get_format_string(format),
+              stroke_kind_name_table[uint32_t(stroke)],
+              shape_path_mode_name_table[uint32_t(shape_path)]);
+          }
+
+          run_canvas_tests(params, json);
+          save_calibration_cache();
+        }
+      }
+    }
+  }
+
+  json.close_array(true);
+  json.close_object(true);
+  json.nl();
+
+  _record_writer.close();
+
+  if (_verify) {
+    printf("Verification: %llu test(s) below %0.1f dB PSNR compared to the reference\n",
+      (unsigned long long)_verify_outliers,
+      _verify_psnr);
+  }
+
+  if (_time_budget.enabled()) {
+    printf("Time budget: %0.1fs used of %0.1fs, %llu test(s) aborted over their share\n",
+      _time_budget.elapsed(),
+      _time_budget.seconds,
+      (unsigned long long)_time_budget.over_budget_count);
+  }
+
+  printf("\n");
+  fputs(json_content.data(), stdout);
+
+  return 0;
+}
+
+// Soak mode renders a single test in a loop for a fixed wall time, so profilers see a single hot path. There is no
+// calibration, no table, and no JSON - only START/STOP markers on stdout, which tooling can wait for. If a perf
+// control FIFO is given, perf is enabled right after START and disabled right before STOP.
+int BenchApp::run_soak() {
+  constexpr uint32_t default_soak_quantity = 1000;
+
+  uint32_t backend_index = 0;
+  while (backend_index < kBackendKindCount && !((supported_backends_mask & _backends) & (1u << backend_index)))
+    backend_index++;
+
+  Backend* backend = nullptr;
+  switch (backend_index < kBackendKindCount ? BackendKind(backend_index) : BackendKind::kNull) {
+    case BackendKind::kBlend2D: backend = create_blend2d_backend(_thread_counts.empty() ? 0u : _thread_counts[0], _soak_no_jit ? 0xFFFFFFFFu : 0u); break;
+#if defined(BLEND2D_APPS_ENABLE_AGG)
+    case BackendKind::kAGG: backend = create_agg_backend(); break;
+#endif
+#if defined(BLEND2D_APPS_ENABLE_CAIRO)
+    case BackendKind::kCairo: backend = create_cairo_backend(); break;
+#endif
+#if defined(BLEND2D_APPS_ENABLE_QT)
+    case BackendKind::kQt: backend = create_qt_backend(); break;
+#endif
+#if defined(BLEND2D_APPS_ENABLE_SKIA)
+    case BackendKind::kSkia: backend = create_skia_backend(); break;
+#endif
+#if defined(BLEND2D_APPS_ENABLE_JUCE)
+    case BackendKind::kJUCE: backend = create_juce_backend(); break;
+#endif
+#if defined(BLEND2D_APPS_ENABLE_COREGRAPHICS)
+    case BackendKind::kCoreGraphics: backend = create_cg_backend(); break;
+#endif
+    default: backend = create_null_backend(); break;
+  }
+
+  BenchParams params{};
+  params.screen_w = uint32_t(_canvases[0].w);
+  params.screen_h = uint32_t(_canvases[0].h);
+  params.format = _formats[0];
+  params.quantity = _quantity ? _quantity : default_soak_quantity;
+  params.testKind = _soak.test;
+  params.style = _soak.style;
+  params.comp_op = _comp_op != 0xFFFFFFFFu ? BLCompOp(_comp_op) : BL_COMP_OP_SRC_OVER;
+  params.shape_size = _soak.shape_size;
+  params.stroke = StrokeKind::kDefault;
+  params.stroke_width = stroke_options_of(params.stroke).width;
+  params.shape_path = ShapePathMode::kReplay;
+
+  if (!backend->supports_format(params.format) ||
+      !backend->supports_comp_op(params.comp_op) ||
+      !backend->supports_style(params.style) ||
+      !backend->supports_test(params.testKind) ||
+      !is_style_applicable(params.testKind, params.style)) {
+    printf("ERROR: Backend '%s' doesn't support the soak configuration\n", backend->name());
+    delete backend;
+    return 1;
+  }
+
+  FILE* perf_ctl = nullptr;
+  if (_perf_ctl_file) {
+    // Blocks until perf opens the FIFO for reading.
+    perf_ctl = fopen(_perf_ctl_file, "w");
+    if (!perf_ctl) {
+      printf("ERROR: Failed to open --perf-ctl=%s\n", _perf_ctl_file);
+      delete backend;
+      return 1;
+    }
+  }
+
+  // Warm up (sprite scaling, JIT compilation of pipelines, allocations) before the soak starts.
+  backend->run(*this, params);
+
+  printf("SOAK START pid=%u backend=\"%s\" test=%s style=%s size=%u comp_op=%s quantity=%u seconds=%g\n",
+    get_process_id(),
+    backend->name(),
+    test_kind_name_table[uint32_t(params.testKind)],
+    style_kind_name_table[uint32_t(params.style)],
+    params.shape_size,
+    comp_op_name_table[uint32_t(params.comp_op)],
+    params.quantity,
+    _soak.seconds);
+  fflush(stdout);
+
+  if (perf_ctl) {
+    fputs("enable\n", perf_ctl);
+    fflush(perf_ctl);
+  }
+
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start_time = Clock::now();
+
+  uint64_t run_count = 0;
+  uint64_t render_duration = 0;
+  double elapsed = 0.0;
+
+  do {
+    backend->run(*this, params);
+    render_duration += backend->_duration;
+    run_count++;
+    elapsed = std::chrono::duration<double>(Clock::now() - start_time).count();
+  } while (elapsed < _soak.seconds);
+
+  if (perf_ctl) {
+    fputs("disable\n", perf_ctl);
+    fclose(perf_ctl);
+  }
+
+  uint64_t call_count = run_count * params.quantity;
+  printf("SOAK STOP pid=%u runs=%llu calls=%llu elapsed=%0.3fs cpms=%0.3f\n",
+    get_process_id(),
+    (unsigned long long)run_count,
+    (unsigned long long)call_count,
+    elapsed,
+    double(call_count) * 1000.0 / double(render_duration ? render_duration : uint64_t(1)));
+  fflush(stdout);
+
+  delete backend;
+  return 0;
+}
+
+// Runs all enabled backends using the canvas size and pixel format specified by `params`.
+void BenchApp::run_canvas_tests(BenchParams& params, JSONBuilder& json) {
+  // Results of Blend2D backends (one per thread count) used to report multi-threaded scaling.
+  std::vector<BackendResults> blend2d_results;
+
+  // Results of all backends used to report speedup relative to the baseline backend (only if enabled).
+  std::vector<BackendResults> backend_results;
+
+  auto results_of_next_backend = [&]() -> BackendResults* {
+    if (!_baseline_backend)
+      return nullptr;
+
+    backend_results.emplace_back();
+    return &backend_results.back();
+  };
+
+  // Null backend runs first as it measures the overhead that can be subtracted from results of other backends. It
+  // renders nothing, thus it's not compared to the baseline.
+  if (is_backend_enabled(BackendKind::kNull)) {
+    Backend* backend = create_null_backend();
+    run_backend_tests(*backend, params, json);
+    delete backend;
+  }
+
   if (_isolated) {
     BLRuntimeSystemInfo si;
     BLRuntime::query_system_info(&si);
 
-    // Only use features that could actually make a difference.
-    static const uint32_t x86_features[] = {
-      BL_RUNTIME_CPU_FEATURE_X86_SSE2,
-      BL_RUNTIME_CPU_FEATURE_X86_SSE3,
-      BL_RUNTIME_CPU_FEATURE_X86_SSSE3,
-      BL_RUNTIME_CPU_FEATURE_X86_SSE4_1,
-      BL_RUNTIME_CPU_FEATURE_X86_SSE4_2,
-      BL_RUNTIME_CPU_FEATURE_X86_AVX,
-      BL_RUNTIME_CPU_FEATURE_X86_AVX2,
-      BL_RUNTIME_CPU_FEATURE_X86_AVX512
-    };
-
-    const uint32_t* features = x86_features;
-    uint32_t feature_count = ARRAY_SIZE(x86_features);
+    const uint32_t* features = isolated_cpu_feature_table;
+    uint32_t feature_count = ARRAY_SIZE(isolated_cpu_feature_table);
 
     for (uint32_t i = 0; i < feature_count; i++) {
       if ((si.cpu_features & features[i]) == features[i]) {
         Backend* backend = create_blend2d_backend(0, features[i]);
-        run_backend_tests(*backend, params, json);
+        run_backend_tests(*backend, params, json, results_of_next_backend());
         delete backend;
       }
     }
   }
   else {
     if (is_backend_enabled(BackendKind::kBlend2D)) {
-      Backend* backend = backend = create_blend2d_backend(0);
-      run_backend_tests(*backend, params, json);
-      delete backend;
+      blend2d_results.resize(_thread_counts.size());
 
-      backend = create_blend2d_backend(2);
-      run_backend_tests(*backend, params, json);
-      delete backend;
+      for (size_t i = 0; i < _thread_counts.size(); i++) {
+        Backend* backend = create_blend2d_backend(_thread_counts[i]);
+        run_backend_tests(*backend, params, json, &blend2d_results[i]);
 
-      backend = create_blend2d_backend(4);
-      run_backend_tests(*backend, params, json);
-      delete backend;
+        if (_baseline_backend)
+          backend_results.push_back(blend2d_results[i]);
+        delete backend;
+      }
     }
 
 #if defined(BLEND2D_APPS_ENABLE_AGG)
     if (is_backend_enabled(BackendKind::kAGG)) {
       Backend* backend = create_agg_backend();
-      run_backend_tests(*backend, params, json);
+      run_backend_tests(*backend, params, json, results_of_next_backend());
       delete backend;
     }
 #endif
@@ -681,7 +1825,7 @@ int BenchApp::run() {
 #if defined(BLEND2D_APPS_ENABLE_CAIRO)
     if (is_backend_enabled(BackendKind::kCairo)) {
       Backend* backend = create_cairo_backend();
-      run_backend_tests(*backend, params, json);
+      run_backend_tests(*backend, params, json, results_of_next_backend());
       delete backend;
     }
 #endif
@@ -689,7 +1833,7 @@ int BenchApp::run() {
 #if defined(BLEND2D_APPS_ENABLE_QT)
     if (is_backend_enabled(BackendKind::kQt)) {
       Backend* backend = create_qt_backend();
-      run_backend_tests(*backend, params, json);
+      run_backend_tests(*backend, params, json, results_of_next_backend());
       delete backend;
     }
 #endif
@@ -697,7 +1841,7 @@ int BenchApp::run() {
 #if defined(BLEND2D_APPS_ENABLE_SKIA)
     if (is_backend_enabled(BackendKind::kSkia)) {
       Backend* backend = create_skia_backend();
-      run_backend_tests(*backend, params, json);
+      run_backend_tests(*backend, params, json, results_of_next_backend());
       delete backend;
     }
 #endif
@@ -705,7 +1849,7 @@ int BenchApp::run() {
 #if defined(BLEND2D_APPS_ENABLE_JUCE)
     if (is_backend_enabled(BackendKind::kJUCE)) {
       Backend* backend = create_juce_backend();
-      run_backend_tests(*backend, params, json);
+      run_backend_tests(*backend, params, json, results_of_next_backend());
       delete backend;
     }
 #endif
@@ -713,35 +1857,45 @@ int BenchApp::run() {
 #if defined(BLEND2D_APPS_ENABLE_COREGRAPHICS)
     if (is_backend_enabled(BackendKind::kCoreGraphics)) {
       Backend* backend = create_cg_backend();
-      run_backend_tests(*backend, params, json);
+      run_backend_tests(*backend, params, json, results_of_next_backend());
       delete backend;
     }
 #endif
   }
 
-  json.close_array(true);
-  json.close_object(true);
-  json.nl();
+  if (blend2d_results.size() > 1) {
+    report_scaling(json, params, blend2d_results);
+  }
 
-  printf("\n");
-  fputs(json_content.data(), stdout);
+  if (_baseline_backend) {
+    report_speedup(json, params, backend_results);
+  }
+
+  if (_farm && is_backend_enabled(BackendKind::kBlend2D)) {
+    run_farm_tests(params, json);
+  }
 
-  return 0;
 }
 
-int BenchApp::run_backend_tests(Backend& backend, BenchParams& params, JSONBuilder& json) {
+int BenchApp::run_backend_tests(Backend& backend, BenchParams& params, JSONBuilder& json, BackendResults* results_out) {
   char file_name[256];
   char style_string[128];
 
   BLImage overview_image;
   BLContext overview_ctx;
 
+  uint32_t w = params.screen_w;
+  uint32_t h = params.screen_h;
+
   if (_save_overview) {
-    overview_image.create(1 + ((_width + 1) * _size_count), _height + 2, BL_FORMAT_XRGB32);
+    overview_image.create(1 + ((w + 1) * _size_count), h + 2, BL_FORMAT_XRGB32);
     overview_ctx.begin(overview_image);
   }
 
   double cpms[kBenchShapeSizeCount] {};
+  double raw_cpms[kBenchShapeSizeCount] {};
+  double cold_cpms[kBenchShapeSizeCount] {};
+  TestResult results[kBenchShapeSizeCount] {};
   uint64_t cpms_total[kBenchShapeSizeCount] {};
   DurationFormat fmt[kBenchShapeSizeCount] {};
 
@@ -752,56 +1906,134 @@ int BenchApp::run_backend_tests(Backend& backend, BenchParams& params, JSONBuild
     comp_op_first = comp_op_last = _comp_op;
   }
 
+  // Number of tests of a single comp op and style - tests that are not supported are skipped in the time budget.
+  uint64_t style_test_count = uint64_t(enabled_test_count(params.stroke, params.shape_path)) * _size_count;
+  uint64_t comp_op_test_count = style_test_count * enabled_style_count();
+
+  if (!backend.supports_format(params.format) ||
+      !backend.supports_stroke(params.stroke) ||
+      !backend.supports_shape_path(params.shape_path)) {
+    _time_budget.skip(comp_op_test_count * (comp_op_last - comp_op_first + 1));
+    return 0;
+  }
+
+  bool is_null_backend = strcmp(backend.name(), backend_kind_name_table[uint32_t(BackendKind::kNull)]) == 0;
+  bool subtract_overhead = _subtract_overhead && !is_null_backend;
+
+  if (results_out) {
+    results_out->name = backend.name();
+    results_out->reset();
+  }
+
+  // Reference images used by --verify are rendered by a single-threaded Blend2D backend, which is not verified.
+  Backend* reference = nullptr;
+  if (_verify && !is_null_backend) {
+    reference = create_blend2d_backend(0);
+    if (strcmp(reference->name(), backend.name()) == 0) {
+      delete reference;
+      reference = nullptr;
+    }
+  }
+
   json.before_record().open_object();
   json.before_record().add_key("name").add_string(backend.name());
+  json.before_record().add_key("canvas").add_stringf("%ux%u", params.screen_w, params.screen_h);
+  json.before_record().add_key("format").add_string(get_format_string(params.format));
+  json.before_record().add_key("stroke").add_string(stroke_kind_name_table[uint32_t(params.stroke)]);
+  json.before_record().add_key("shapePath").add_string(shape_path_mode_name_table[uint32_t(params.shape_path)]);
   backend.serialize_info(json);
   json.before_record().add_key("records").open_array();
 
   for (uint32_t comp_op = comp_op_first; comp_op <= comp_op_last; comp_op++) {
     params.comp_op = BLCompOp(comp_op);
-    if (!backend.supports_comp_op(params.comp_op))
+    if (!backend.supports_comp_op(params.comp_op)) {
+      _time_budget.skip(comp_op_test_count);
       continue;
+    }
 
     for (uint32_t style_index = 0; style_index < kStyleKindCount; style_index++) {
       StyleKind style = StyleKind(style_index);
-      if (!is_style_enabled(style) || !backend.supports_style(style)) {
+      if (!is_style_enabled(style))
+        continue;
+
+      if (!backend.supports_style(style)) {
+        _time_budget.skip(style_test_count);
         continue;
       }
 
       params.style = style;
 
-      // Remove '@' from the style name if not running a deep benchmark.
-      strcpy(style_string, style_kind_name_table[style_index]);
-
-      if (!_deep_bench) {
-        char* x = strchr(style_string, '@');
-        if (x != nullptr) x[0] = '\0';
-      }
+      format_style_name(style_string, style_index, _deep_bench || _style_mask);
 
       memset(cpms_total, 0, sizeof(cpms_total));
 
       printf(bench_border_str);
-      printf(bench_header_str, backend._name);
+      print_table_header(backend._name);
       printf(bench_border_str);
 
       for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++) {
+        if (!is_test_enabled(TestKind(test_index), params.stroke, params.shape_path))
+          continue;
+
         params.testKind = TestKind(test_index);
 
+        if (!backend.supports_test(params.testKind) || !is_style_applicable(params.testKind, style)) {
+          _time_budget.skip(_size_count);
+          continue;
+        }
+
         if (_save_overview) {
           overview_ctx.fill_all(BLRgba32(0xFF000000u));
           overview_ctx.stroke_rect(BLRect(0.5, 0.5, overview_image.width() - 1, overview_image.height() - 1), BLRgba32(0xFFFFFFFF));
         }
 
         for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
-          params.shape_size = bench_shape_size_table[size_index];
-          uint64_t duration = run_single_test(backend, params);
+          params.shape_size = _shape_sizes[size_index];
+          run_single_test(backend, params, results[size_index]);
+
+          if (reference) {
+            // The reference uses the same quantity, so both backends render the same deterministic workload.
+            TestResult& result = results[size_index];
+            reference->run(*this, params);
+            result.verified = compare_images(result.diff, backend._surface, reference->_surface);
+
+            if (result.verified && is_verify_outlier(result.diff))
+              _verify_outliers++;
+          }
+
+          if (_cold) {
+            // The cold pass evicts caches before each render call, thus it renders at most `kBenchColdQuantity`
+            // calls of the warm pass quantity - results of both passes are in calls per millisecond.
+            TestResult cold_result {};
+            _cold_pass = true;
+            run_single_test(backend, params, cold_result, std::min(results[size_index].quantity, kBenchColdQuantity));
+            _cold_pass = false;
+            cold_cpms[size_index] = duration_to_cpms(cold_result.quantity, cold_result.duration);
+          }
+
+          double& overhead = _overhead[style_index][test_index][size_index];
+          double per_call = double(results[size_index].duration) / double(results[size_index].quantity);
+
+          raw_cpms[size_index] = duration_to_cpms(params.quantity, results[size_index].duration);
+          cpms[size_index] = raw_cpms[size_index];
+
+          if (is_null_backend) {
+            overhead = per_call;
+          }
+          else if (subtract_overhead && per_call > overhead) {
+            // Overhead larger than the measured time is noise - keep the raw result in that case.
+            cpms[size_index] = 1000.0 / (per_call - overhead);
+          }
 
-          cpms[size_index] = double(params.quantity) * double(1000) / double(duration);
           cpms_total[size_index] += cpms[size_index];
 
+          if (results_out) {
+            results_out->set(comp_op, style_index, test_index, size_index, cpms[size_index]);
+          }
+
           if (_save_overview) {
-            overview_ctx.blit_image(BLPointI(1 + (size_index * (_width + 1)), 1), backend._surface);
-            overview_ctx.fill_rect(BLRectI(1 + (size_index * (_width + 1)) + _width, 1, 1, _height), BLRgba32(0xFFFFFFFF));
+            overview_ctx.blit_image(BLPointI(1 + (size_index * (w + 1)), 1), backend._surface);
+            overview_ctx.fill_rect(BLRectI(1 + (size_index * (w + 1)) + w, 1, 1, h), BLRgba32(0xFFFFFFFF));
             if (size_index == _size_count - 1) {
               snprintf(file_name, 256, "%s-%s-%s-%s.png",
                 backend._name,
@@ -843,8 +2075,38 @@ int BenchApp::run_backend_tests(Backend& backend, BenchParams& params, JSONBuild
           fmt[4].data,
           fmt[5].data);
 
-        json.before_record()
-            .open_object()
+        uint32_t glyph_count = glyphs_per_call(params.testKind);
+        if (glyph_count) {
+          print_glyph_rate(cpms, glyph_count, _size_count);
+        }
+
+        uint32_t vertex_count = vertices_per_call(params.testKind);
+        if (vertex_count) {
+          print_vertex_rate(cpms, vertex_count, _size_count);
+        }
+
+        if (_alloc_stats) {
+          print_alloc_stats(results, _size_count);
+        }
+
+        if (_cold) {
+          DurationFormat cold_fmt[kBenchShapeSizeCount] {};
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            cold_fmt[size_index].format(cold_cpms[size_index]);
+          }
+
+          printf(bench_fata_fmt_str, "  cold", "", "",
+            cold_fmt[0].data, cold_fmt[1].data, cold_fmt[2].data, cold_fmt[3].data, cold_fmt[4].data, cold_fmt[5].data);
+        }
+
+        if (reference) {
+          print_verify(*this, results, _size_count);
+        }
+
+        json.before_record();
+        size_t record_start = json._dst->size();
+
+        json.open_object()
             .add_key("test").add_string(test_kind_name_table[uint32_t(params.testKind)])
             .comma().align_to(36).add_key("compOp").add_string(comp_op_name_table[uint32_t(params.comp_op)])
             .comma().align_to(58).add_key("style").add_string(style_string);
@@ -855,7 +2117,81 @@ int BenchApp::run_backend_tests(Backend& backend, BenchParams& params, JSONBuild
         }
         json.close_array();
 
+        if (subtract_overhead) {
+          json.add_key("rawRcpms").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            DurationFormat raw_fmt;
+            raw_fmt.format(raw_cpms[size_index]);
+            json.add_stringWithoutQuotes(raw_fmt.data);
+          }
+          json.close_array();
+        }
+
+        if (_cold) {
+          json.add_key("coldRcpms").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            DurationFormat cold_fmt;
+            cold_fmt.format(cold_cpms[size_index]);
+            json.add_stringWithoutQuotes(cold_fmt.data);
+          }
+          json.close_array();
+        }
+
+        json.add_key("samples").open_array();
+        for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+          json.add_uint(results[size_index].stats.count);
+        }
+        json.close_array();
+
+        add_stats_array(json, "median", results, _size_count, &SampleStats::median);
+        add_stats_array(json, "p5", results, _size_count, &SampleStats::p5);
+        add_stats_array(json, "p95", results, _size_count, &SampleStats::p95);
+        add_stats_array(json, "stddev", results, _size_count, &SampleStats::stddev);
+        add_stats_array(json, "ciLow", results, _size_count, &SampleStats::ci_low);
+        add_stats_array(json, "ciHigh", results, _size_count, &SampleStats::ci_high);
+
+        if (_perf_counters) {
+          add_perf_counters(json, results, _size_count);
+        }
+
+        if (_latency) {
+          add_latency(json, results, _size_count);
+        }
+
+        if (_alloc_stats) {
+          add_alloc_stats(json, results, _size_count);
+        }
+
+        if (glyph_count) {
+          json.add_key("glyphsPerSecond").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            json.add_doublef("%0.0f", cpms[size_index] * double(glyph_count) * 1000.0);
+          }
+          json.close_array();
+        }
+
+        if (vertex_count) {
+          json.add_key("verticesPerSecond").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            json.add_doublef("%0.0f", cpms[size_index] * double(vertex_count) * 1000.0);
+          }
+          json.close_array();
+        }
+
+        if (reference) {
+          add_verify(json, *this, results, _size_count);
+        }
+
+        if (_time_budget.enabled()) {
+          json.add_key("overBudget").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            json.add_bool(results[size_index].over_budget);
+          }
+          json.close_array();
+        }
+
         json.close_object();
+        stream_record(backend.name(), params, json, record_start);
       }
 
       for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
@@ -881,36 +2217,697 @@ int BenchApp::run_backend_tests(Backend& backend, BenchParams& params, JSONBuild
   json.close_array(true);
   json.close_object(true);
 
+  delete reference;
+  return 0;
+}
+
+// Speedup is relative to the synchronous context (thread count 0) if benchmarked, otherwise to the lowest thread
+// count. Efficiency is speedup divided by thread count (synchronous context counts as a single thread).
+void BenchApp::report_scaling(JSONBuilder& json, const BenchParams& params, const std::vector<BackendResults>& results) const {
+  char name_string[64];
+  char style_string[128];
+  char cell[kBenchShapeSizeCount][64];
+
+  size_t base_index = 0;
+  for (size_t i = 1; i < _thread_counts.size(); i++) {
+    if (_thread_counts[i] < _thread_counts[base_index])
+      base_index = i;
+  }
+
+  uint32_t comp_op_first = BL_COMP_OP_SRC_OVER;
+  uint32_t comp_op_last  = BL_COMP_OP_SRC_COPY;
+
+  if (_comp_op != 0xFFFFFFFFu) {
+    comp_op_first = comp_op_last = _comp_op;
+  }
+
+  json.before_record().open_object();
+  json.before_record().add_key("name").add_string("Blend2D Scaling");
+  json.before_record().add_key("canvas").add_stringf("%ux%u", params.screen_w, params.screen_h);
+  json.before_record().add_key("format").add_string(get_format_string(params.format));
+  json.before_record().add_key("baseThreads").add_uint(_thread_counts[base_index]);
+  json.before_record().add_key("records").open_array();
+
+  for (size_t i = 0; i < _thread_counts.size(); i++) {
+    if (i == base_index)
+      continue;
+
+    uint32_t thread_count = _thread_counts[i];
+    double effective_threads = double(thread_count ? thread_count : 1u);
+    snprintf(name_string, sizeof(name_string), "Scaling %uT", thread_count);
+
+    for (uint32_t comp_op = comp_op_first; comp_op <= comp_op_last; comp_op++) {
+      for (uint32_t style_index = 0; style_index < kStyleKindCount; style_index++) {
+        if (!is_style_enabled(StyleKind(style_index)))
+          continue;
+
+        double cpms[kTestKindCount][kBenchShapeSizeCount] {};
+        double speedup[kTestKindCount][kBenchShapeSizeCount] {};
+        double efficiency[kTestKindCount][kBenchShapeSizeCount] {};
+        bool has_ratio[kTestKindCount] {};
+        bool has_any_ratio = false;
+
+        for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++) {
+          if (!is_test_enabled(TestKind(test_index), params.stroke, params.shape_path))
+            continue;
+
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            double base = results[base_index].get(comp_op, style_index, test_index, size_index);
+            double current = results[i].get(comp_op, style_index, test_index, size_index);
+
+            // Skip sizes that were not run by both thread counts (unsupported style, comp op, or stroke).
+            if (base > 0.0 && current > 0.0) {
+              cpms[test_index][size_index] = current;
+              speedup[test_index][size_index] = current / base;
+              efficiency[test_index][size_index] = speedup[test_index][size_index] / effective_threads;
+              has_ratio[test_index] = true;
+              has_any_ratio = true;
+            }
+          }
+        }
+
+        if (!has_any_ratio)
+          continue;
+
+        format_style_name(style_string, style_index, _deep_bench || _style_mask);
+
+        printf(bench_border_str);
+        print_table_header(name_string);
+        printf(bench_border_str);
+
+        for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++) {
+          if (!has_ratio[test_index])
+            continue;
+
+          for (uint32_t size_index = 0; size_index < kBenchShapeSizeCount; size_index++) {
+            if (size_index >= _size_count)
+              cell[size_index][0] = '\0';
+            else if (speedup[test_index][size_index] > 0.0)
+              snprintf(cell[size_index], sizeof(cell[size_index]), "%0.1fx %3.0f%%", speedup[test_index][size_index], efficiency[test_index][size_index] * 100.0);
+            else
+              snprintf(cell[size_index], sizeof(cell[size_index]), "-");
+          }
+
+          printf(bench_fata_fmt_str,
+            test_kind_name_table[test_index],
+            comp_op_name_table[comp_op],
+            style_string,
+            cell[0],
+            cell[1],
+            cell[2],
+            cell[3],
+            cell[4],
+            cell[5]);
+
+          json.before_record();
+          size_t record_start = json._dst->size();
+
+          json.open_object()
+              .add_key("test").add_string(test_kind_name_table[test_index])
+              .comma().align_to(36).add_key("compOp").add_string(comp_op_name_table[comp_op])
+              .comma().align_to(58).add_key("style").add_string(style_string)
+              .add_key("threads").add_uint(thread_count);
+
+          DurationFormat fmt;
+          // Sizes without data of both thread counts are null, thus they cannot be mistaken for a zero speedup.
+          json.add_key("rcpms").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            if (cpms[test_index][size_index] > 0.0) {
+              fmt.format(cpms[test_index][size_index]);
+              json.add_stringWithoutQuotes(fmt.data);
+            }
+            else {
+              json.add_stringWithoutQuotes("null");
+            }
+          }
+          json.close_array();
+
+          json.add_key("speedup").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            if (speedup[test_index][size_index] > 0.0)
+              json.add_doublef("%0.3f", speedup[test_index][size_index]);
+            else
+              json.add_stringWithoutQuotes("null");
+          }
+          json.close_array();
+
+          json.add_key("efficiency").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            if (efficiency[test_index][size_index] > 0.0)
+              json.add_doublef("%0.3f", efficiency[test_index][size_index]);
+            else
+              json.add_stringWithoutQuotes("null");
+          }
+          json.close_array();
+
+          json.close_object();
+          stream_record("Blend2D Scaling", params, json, record_start);
+        }
+
+        printf(bench_border_str);
+        printf("\n");
+      }
+    }
+  }
+
+  json.close_array(true);
+  json.close_object(true);
+}
+
+// Ratios are throughput of a backend divided by throughput of the baseline (higher is faster). Tests that were not
+// run by either backend have no ratio and are excluded from geometric means.
+void BenchApp::report_speedup(JSONBuilder& json, const BenchParams& params, const std::vector<BackendResults>& results) const {
+  char style_string[128];
+  char cell[kBenchShapeSizeCount][64];
+
+  const BackendResults* baseline = nullptr;
+  for (const BackendResults& r : results) {
+    if (strieq(r.name.c_str(), _baseline_backend)) {
+      baseline = &r;
+      break;
+    }
+  }
+
+  if (!baseline) {
+    printf("WARNING: Baseline backend '%s' was not benchmarked, speedup cannot be reported\n\n", _baseline_backend);
+    return;
+  }
+
+  uint32_t comp_op_first = BL_COMP_OP_SRC_OVER;
+  uint32_t comp_op_last  = BL_COMP_OP_SRC_COPY;
+
+  if (_comp_op != 0xFFFFFFFFu) {
+    comp_op_first = comp_op_last = _comp_op;
+  }
+
+  printf("Speedup relative to '%s' (higher is faster):\n\n", baseline->name.c_str());
+
+  json.before_record().open_object();
+  json.before_record().add_key("name").add_string("Speedup");
+  json.before_record().add_key("canvas").add_stringf("%ux%u", params.screen_w, params.screen_h);
+  json.before_record().add_key("format").add_string(get_format_string(params.format));
+  json.before_record().add_key("baseline").add_string(baseline->name.c_str());
+  json.before_record().add_key("records").open_array();
+
+  // Sum of logarithms and count of all ratios of each backend (overall geometric mean).
+  std::vector<double> overall_log_sum(results.size());
+  std::vector<uint64_t> overall_count(results.size());
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const BackendResults& r = results[i];
+    if (&r == baseline)
+      continue;
+
+    for (uint32_t comp_op = comp_op_first; comp_op <= comp_op_last; comp_op++) {
+      for (uint32_t style_index = 0; style_index < kStyleKindCount; style_index++) {
+        if (!is_style_enabled(StyleKind(style_index)))
+          continue;
+
+        double speedup[kTestKindCount][kBenchShapeSizeCount] {};
+        double style_log_sum[kBenchShapeSizeCount] {};
+        uint32_t style_count[kBenchShapeSizeCount] {};
+        bool has_ratio = false;
+
+        for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++) {
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            double base = baseline->get(comp_op, style_index, test_index, size_index);
+            double cpms = r.get(comp_op, style_index, test_index, size_index);
+
+            if (base > 0.0 && cpms > 0.0) {
+              double ratio = cpms / base;
+              speedup[test_index][size_index] = ratio;
+              style_log_sum[size_index] += std::log(ratio);
+              style_count[size_index]++;
+              has_ratio = true;
+            }
+          }
+        }
+
+        // Skip combinations that were not run by both backends (unsupported comp op or style).
+        if (!has_ratio)
+          continue;
+
+        format_style_name(style_string, style_index, _deep_bench || _style_mask);
+
+        printf(bench_border_str);
+        print_table_header(r.name.c_str());
+        printf(bench_border_str);
+
+        for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++) {
+          if (!is_test_enabled(TestKind(test_index), params.stroke, params.shape_path))
+            continue;
+
+          for (uint32_t size_index = 0; size_index < kBenchShapeSizeCount; size_index++) {
+            double ratio = speedup[test_index][size_index];
+            if (size_index >= _size_count)
+              cell[size_index][0] = '\0';
+            else if (ratio > 0.0)
+              snprintf(cell[size_index], sizeof(cell[size_index]), "%0.2fx", ratio);
+            else
+              snprintf(cell[size_index], sizeof(cell[size_index]), "-");
+          }
+
+          printf(bench_fata_fmt_str,
+            test_kind_name_table[test_index],
+            comp_op_name_table[comp_op],
+            style_string,
+            cell[0],
+            cell[1],
+            cell[2],
+            cell[3],
+            cell[4],
+            cell[5]);
+
+          json.before_record();
+          size_t record_start = json._dst->size();
+
+          json.open_object()
+              .add_key("test").add_string(test_kind_name_table[test_index])
+              .comma().align_to(36).add_key("compOp").add_string(comp_op_name_table[comp_op])
+              .comma().align_to(58).add_key("style").add_string(style_string)
+              .add_key("backend").add_string(r.name.c_str());
+
+          // Sizes without a ratio are null, thus they cannot be mistaken for a zero speedup.
+          json.add_key("speedup").open_array();
+          for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+            if (speedup[test_index][size_index] > 0.0)
+              json.add_doublef("%0.3f", speedup[test_index][size_index]);
+            else
+              json.add_stringWithoutQuotes("null");
+          }
+          json.close_array();
+
+          json.close_object();
+          stream_record("Speedup", params, json, record_start);
+        }
+
+        double geomean[kBenchShapeSizeCount] {};
+        for (uint32_t size_index = 0; size_index < kBenchShapeSizeCount; size_index++) {
+          if (size_index < _size_count && style_count[size_index]) {
+            geomean[size_index] = std::exp(style_log_sum[size_index] / double(style_count[size_index]));
+            snprintf(cell[size_index], sizeof(cell[size_index]), "%0.2fx", geomean[size_index]);
+
+            overall_log_sum[i] += style_log_sum[size_index];
+            overall_count[i] += style_count[size_index];
+          }
+          else {
+            cell[size_index][0] = '\0';
+          }
+        }
+
+        printf(bench_border_str);
+        printf(bench_fata_fmt_str,
+          "Geomean",
+          comp_op_name_table[comp_op],
+          style_string,
+          cell[0],
+          cell[1],
+          cell[2],
+          cell[3],
+          cell[4],
+          cell[5]);
+        printf(bench_border_str);
+        printf("\n");
+
+        json.before_record();
+        size_t record_start = json._dst->size();
+
+        json.open_object()
+            .add_key("test").add_string("Geomean")
+            .comma().align_to(36).add_key("compOp").add_string(comp_op_name_table[comp_op])
+            .comma().align_to(58).add_key("style").add_string(style_string)
+            .add_key("backend").add_string(r.name.c_str());
+
+        json.add_key("speedup").open_array();
+        for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+          if (geomean[size_index] > 0.0)
+            json.add_doublef("%0.3f", geomean[size_index]);
+          else
+            json.add_stringWithoutQuotes("null");
+        }
+        json.close_array();
+
+        json.close_object();
+        stream_record("Speedup", params, json, record_start);
+      }
+    }
+  }
+
+  json.close_array(true);
+
+  printf("Overall geometric mean of speedup relative to '%s':\n", baseline->name.c_str());
+  json.before_record().add_key("geomean").open_object();
+
+  for (size_t i = 0; i < results.size(); i++) {
+    if (&results[i] == baseline || !overall_count[i])
+      continue;
+
+    double geomean = std::exp(overall_log_sum[i] / double(overall_count[i]));
+    printf("  %-20s %0.3fx\n", results[i].name.c_str(), geomean);
+    json.before_record().add_key(results[i].name.c_str()).add_doublef("%0.3f", geomean);
+  }
+
+  json.close_object(true);
+  json.close_object(true);
+
+  printf("\n");
+}
+
+// Each test is first run by a single backend on the calling thread (like any other test), which calibrates the
+// quantity and provides a reference. Then all farm threads render the same test concurrently, each using its own
+// backend, surface, and context, which exposes contention in shared state (memory bandwidth, JIT, allocators).
+int BenchApp::run_farm_tests(BenchParams& params, JSONBuilder& json) {
+  char name_string[64];
+  char style_string[128];
+
+  uint32_t thread_count = _farm;
+  std::vector<Backend*> backends(thread_count);
+
+  for (uint32_t i = 0; i < thread_count; i++) {
+    backends[i] = create_blend2d_backend(0);
+  }
+
+  // All backends of the farm are Blend2D backends, which don't support all stroke options.
+  if (!backends[0]->supports_stroke(params.stroke) || !backends[0]->supports_shape_path(params.shape_path)) {
+    uint64_t comp_op_count = _comp_op != 0xFFFFFFFFu ? 1u : uint64_t(BL_COMP_OP_SRC_COPY - BL_COMP_OP_SRC_OVER + 1);
+    _time_budget.skip(comp_op_count * enabled_style_count() * enabled_test_count(params.stroke, params.shape_path) * _size_count);
+
+    for (Backend* backend : backends) {
+      delete backend;
+    }
+    return 0;
+  }
+
+  // Scaled sprites are cached on demand, which is not thread-safe - make sure all sizes are cached in advance.
+  for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++) {
+    for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+      get_scaled_sprite(0, sprite_size_of(TestKind(test_index), _shape_sizes[size_index]));
+    }
+  }
+
+  uint32_t comp_op_first = BL_COMP_OP_SRC_OVER;
+  uint32_t comp_op_last  = BL_COMP_OP_SRC_COPY;
+
+  if (_comp_op != 0xFFFFFFFFu) {
+    comp_op_first = comp_op_last = _comp_op;
+  }
+
+  snprintf(name_string, sizeof(name_string), "Farm %ux ST", thread_count);
+
+  json.before_record().open_object();
+  json.before_record().add_key("name").add_string(name_string);
+  json.before_record().add_key("canvas").add_stringf("%ux%u", params.screen_w, params.screen_h);
+  json.before_record().add_key("format").add_string(get_format_string(params.format));
+  json.before_record().add_key("threads").add_uint(thread_count);
+  json.before_record().add_key("records").open_array();
+
+  std::vector<uint64_t> best_durations(thread_count);
+
+  for (uint32_t comp_op = comp_op_first; comp_op <= comp_op_last; comp_op++) {
+    params.comp_op = BLCompOp(comp_op);
+
+    for (uint32_t style_index = 0; style_index < kStyleKindCount; style_index++) {
+      StyleKind style = StyleKind(style_index);
+      if (!is_style_enabled(style))
+        continue;
+
+      params.style = style;
+      format_style_name(style_string, style_index, _deep_bench || _style_mask);
+
+      printf(bench_border_str);
+      print_table_header(name_string);
+      printf(bench_border_str);
+
+      for (uint32_t test_index = 0; test_index < kTestKindCount; test_index++) {
+        if (!is_test_enabled(TestKind(test_index), params.stroke, params.shape_path))
+          continue;
+
+        params.testKind = TestKind(test_index);
+
+        if (!is_style_applicable(params.testKind, style)) {
+          _time_budget.skip(_size_count);
+          continue;
+        }
+
+        double single_cpms[kBenchShapeSizeCount] {};
+        double aggregate_cpms[kBenchShapeSizeCount] {};
+        std::vector<double> thread_cpms(size_t(kBenchShapeSizeCount) * thread_count);
+        DurationFormat fmt[kBenchShapeSizeCount] {};
+
+        for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+          params.shape_size = _shape_sizes[size_index];
+
+          TestResult single {};
+          run_single_test(*backends[0], params, single);
+          single_cpms[size_index] = duration_to_cpms(single.quantity, single.duration);
+
+          std::atomic<uint32_t> ready_count(0);
+          std::atomic<bool> go(false);
+          std::vector<std::thread> threads;
+
+          for (uint32_t i = 0; i < thread_count; i++) {
+            threads.emplace_back([&, i]() {
+              ready_count.fetch_add(1);
+              while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+              uint64_t best = std::numeric_limits<uint64_t>::max();
+              for (uint32_t attempt = 0; attempt < _repeat; attempt++) {
+                backends[i]->run(*this, params);
+                best = std::min(best, backends[i]->_duration);
+              }
+              best_durations[i] = best;
+            });
+          }
+
+          while (ready_count.load() != thread_count)
+            std::this_thread::yield();
+
+          auto start = std::chrono::high_resolution_clock::now();
+          go.store(true, std::memory_order_release);
+
+          for (std::thread& thread : threads)
+            thread.join();
+
+          auto end = std::chrono::high_resolution_clock::now();
+          std::chrono::duration<double> elapsed = end - start;
+
+          // Aggregate throughput is based on the wall time of all threads, which includes all repeats.
+          uint64_t total_calls = uint64_t(single.quantity) * _repeat * thread_count;
+          uint64_t wall_duration = uint64_t(elapsed.count() * 1000000);
+
+          aggregate_cpms[size_index] = double(total_calls) * double(1000) / double(wall_duration ? wall_duration : uint64_t(1));
+          for (uint32_t i = 0; i < thread_count; i++) {
+            thread_cpms[size_index * thread_count + i] = duration_to_cpms(single.quantity, best_durations[i]);
+          }
+
+          fmt[size_index].format(aggregate_cpms[size_index]);
+        }
+
+        printf(bench_fata_fmt_str,
+          test_kind_name_table[test_index],
+          comp_op_name_table[comp_op],
+          style_string,
+          fmt[0].data,
+          fmt[1].data,
+          fmt[2].data,
+          fmt[3].data,
+          fmt[4].data,
+          fmt[5].data);
+
+        json.before_record();
+        size_t record_start = json._dst->size();
+
+        json.open_object()
+            .add_key("test").add_string(test_kind_name_table[test_index])
+            .comma().align_to(36).add_key("compOp").add_string(comp_op_name_table[comp_op])
+            .comma().align_to(58).add_key("style").add_string(style_string);
+
+        json.add_key("rcpms").open_array();
+        for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+          json.add_stringWithoutQuotes(fmt[size_index].data);
+        }
+        json.close_array();
+
+        json.add_key("singleRcpms").open_array();
+        for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+          DurationFormat single_fmt;
+          single_fmt.format(single_cpms[size_index]);
+          json.add_stringWithoutQuotes(single_fmt.data);
+        }
+        json.close_array();
+
+        json.add_key("threadRcpms").open_array();
+        for (uint32_t size_index = 0; size_index < _size_count; size_index++) {
+          json.open_array();
+          for (uint32_t i = 0; i < thread_count; i++) {
+            DurationFormat thread_fmt;
+            thread_fmt.format(thread_cpms[size_index * thread_count + i]);
+            json.add_stringWithoutQuotes(thread_fmt.data);
+          }
+          json.close_array();
+        }
+        json.close_array();
+
+        json.close_object();
+        stream_record(name_string, params, json, record_start);
+      }
+
+      printf(bench_border_str);
+      printf("\n");
+    }
+  }
+
+  json.close_array(true);
+  json.close_object(true);
+
+  for (Backend* backend : backends) {
+    delete backend;
+  }
+
   return 0;
 }
 
-uint64_t BenchApp::run_single_test(Backend& backend, BenchParams& params) {
+// Streams the record that was just serialized into `json` (starting at `record_start`) as a single JSON line. The
+// record is wrapped together with the run name, canvas, and format so each line is self-contained.
+void BenchApp::stream_record(const char* run_name, const BenchParams& params, const JSONBuilder& json, size_t record_start) const {
+  if (!_record_writer.is_open())
+    return;
+
+  BLString record;
+  record.assign(json._dst->data() + record_start, json._dst->size() - record_start);
+
+  BLString line;
+  JSONBuilder line_json(&line);
+
+  line_json.open_object()
+    .add_key("run").add_string(run_name)
+    .add_key("canvas").add_stringf("%ux%u", params.screen_w, params.screen_h)
+    .add_key("format").add_string(get_format_string(params.format))
+    .add_key("stroke").add_string(stroke_kind_name_table[uint32_t(params.stroke)])
+    .add_key("shapePath").add_string(shape_path_mode_name_table[uint32_t(params.shape_path)])
+    .add_key("record").add_stringWithoutQuotes(record.data())
+    .close_object();
+
+  if (!_record_writer.write_line(line.data(), line.size())) {
+    printf("WARNING: Failed to write a record to --output=%s\n", _output_file);
+  }
+}
+
+// The fingerprint invalidates cached quantities when the binary, the CPU, or the target duration changes.
+std::string BenchApp::calibration_fingerprint() const {
+  BLRuntimeBuildInfo build_info;
+  BLRuntime::query_build_info(&build_info);
+
+  BLRuntimeSystemInfo system_info;
+  BLRuntime::query_system_info(&system_info);
+
+  char executable_stamp[64];
+  get_executable_stamp(executable_stamp, sizeof(executable_stamp), _cmd_line._argc > 0 ? _cmd_line._argv[0] : nullptr);
+
+  char buffer[512];
+  snprintf(buffer, sizeof(buffer), "blend2d=%u.%u.%u %s [%s]; bl_bench=%s; cpu=%s; target=%uus",
+    build_info.major_version,
+    build_info.minor_version,
+    build_info.patch_version,
+    build_info.build_type == BL_RUNTIME_BUILD_TYPE_DEBUG ? "Debug" : "Release",
+    build_info.compiler_info,
+    executable_stamp,
+    system_info.cpu_brand,
+    _target_duration);
+  return std::string(buffer);
+}
+
+std::string BenchApp::calibration_key(const Backend& backend, const BenchParams& params) const {
+  // Workload mode and latency mode change the cost of a render call, thus quantities calibrated by them differ.
+  char buffer[512];
+  snprintf(buffer, sizeof(buffer), "%s|%s|%s|%s|%u|%ux%u|%s|%s|%s|%s|%s",
+    backend.name(),
+    test_kind_name_table[uint32_t(params.testKind)],
+    style_kind_name_table[uint32_t(params.style)],
+    comp_op_name_table[uint32_t(params.comp_op)],
+    params.shape_size,
+    params.screen_w,
+    params.screen_h,
+    get_format_string(params.format),
+    stroke_kind_name_table[uint32_t(params.stroke)],
+    shape_path_mode_name_table[uint32_t(params.shape_path)],
+    workload_mode_name_table[uint32_t(_workload_mode)],
+    _latency ? "latency" : "throughput");
+  return std::string(buffer);
+}
+
+void BenchApp::save_calibration_cache() {
+  if (_calibration_file && !_calibration_cache.save(_calibration_file)) {
+    printf("WARNING: Failed to save calibration cache '%s'\n", _calibration_file);
+  }
+}
+
+void BenchApp::run_single_test(Backend& backend, BenchParams& params, TestResult& result, uint32_t fixed_quantity) {
   constexpr uint32_t initial_quantity = 25;
-  constexpr uint32_t minimum_duration_in_us = 1000;
   constexpr uint32_t max_repeat_if_no_improvement = 10;
+  constexpr uint32_t min_samples_if_ci = 5;
 
   uint32_t attempt = 0;
   uint64_t duration = std::numeric_limits<uint64_t>::max();
   uint32_t no_improvement = 0;
 
-  params.quantity = _quantity;
+  // All samples are kept (in calls per millisecond) so the distribution can be reported, not just the best time.
+  std::vector<double> samples;
+
+  params.quantity = fixed_quantity ? fixed_quantity : _quantity;
+  if (_latency)
+    result.latency.reset();
+
+  result.shape_size = params.shape_size;
+  result.over_budget = false;
+  result.verified = false;
 
-  if (_quantity == 0u) {
-    // If quantity is zero it means to deduce it based on execution time of each test.
-    params.quantity = initial_quantity;
+  // With --time-budget each test gets a share of the remaining budget and it's aborted when it goes over it. The
+  // budget is only checked between runs, so each test has at least a single sample.
+  bool use_budget = _time_budget.enabled();
+  double budget_share = use_budget ? _time_budget.next_share() : 0.0;
+  TimeBudget::Clock::time_point test_start = TimeBudget::Clock::now();
+
+  auto is_over_budget = [&]() {
+    return use_budget && std::chrono::duration<double>(TimeBudget::Clock::now() - test_start).count() >= budget_share;
+  };
+
+  if (params.quantity == 0u) {
+    // If quantity is zero it means to deduce it based on execution time of each test. Calibration starts from
+    // a cached quantity if available, which makes it a single run in most cases.
+    std::string cache_key;
+    uint32_t cached_quantity = 0;
+
+    if (_calibration_file) {
+      cache_key = calibration_key(backend, params);
+      cached_quantity = _calibration_cache.get(cache_key);
+    }
+
+    params.quantity = cached_quantity ? cached_quantity : initial_quantity;
     for (;;) {
       backend.run(*this, params);
-      if (backend._duration >= minimum_duration_in_us) {
+      result.latency.merge(backend._latency);
+
+      bool over_budget = is_over_budget();
+      if (backend._duration >= _target_duration || over_budget) {
+        result.over_budget = over_budget && backend._duration < _target_duration;
+        if (_calibration_file && !result.over_budget)
+          _calibration_cache.set(cache_key, params.quantity);
+
         // Make this the first attempt to reduce the time of benchmarking.
         attempt = 1;
         duration = backend._duration;
+        result.counters = backend._counters;
+        result.allocs = backend._allocs;
+        samples.push_back(duration_to_cpms(params.quantity, duration));
         break;
       }
 
-      if (backend._duration < 100) {
+      if (backend._duration < _target_duration / 10u) {
         params.quantity *= 10;
       }
-      else if (backend._duration < 500) {
+      else if (backend._duration < _target_duration / 2u) {
         params.quantity *= 3;
       }
       else {
@@ -919,23 +2916,50 @@ uint64_t BenchApp::run_single_test(Backend& backend, BenchParams& params) {
     }
   }
 
-  while (attempt < _repeat) {
+  // Without --ci the test is repeated exactly `_repeat` times (or until there is no improvement). With --ci the
+  // test is repeated until the confidence interval of the median is narrow enough or `_max_repeat` is reached.
+  // With --time-budget the test is repeated until its share of the budget is used (up to `_max_repeat` times).
+  bool use_ci = _ci > 0.0;
+  uint32_t min_attempts = use_ci ? std::max(_repeat, min_samples_if_ci) : _repeat;
+  uint32_t max_attempts = use_ci || use_budget ? _max_repeat : _repeat;
+
+  while (attempt < max_attempts) {
+    if (use_ci && attempt >= min_attempts) {
+      calculate_sample_stats(result.stats, samples.data(), samples.size());
+      if (result.stats.ci_relative_width() * 100.0 <= _ci)
+        break;
+    }
+
+    if (attempt && is_over_budget()) {
+      result.over_budget |= attempt < min_attempts;
+      break;
+    }
+
     backend.run(*this, params);
+    result.latency.merge(backend._latency);
+    samples.push_back(duration_to_cpms(params.quantity, backend._duration));
 
     if (duration > backend._duration) {
       duration = backend._duration;
+      result.counters = backend._counters;
+      result.allocs = backend._allocs;
     }
     else {
       no_improvement++;
     }
 
-    if (no_improvement >= max_repeat_if_no_improvement)
+    if (!use_ci && !use_budget && no_improvement >= max_repeat_if_no_improvement)
       break;
 
     attempt++;
   }
 
-  return duration;
+  if (result.over_budget)
+    _time_budget.over_budget_count++;
+
+  result.quantity = params.quantity;
+  result.duration = duration;
+  calculate_sample_stats(result.stats, samples.data(), samples.size());
 }
 
 } // {blbench}
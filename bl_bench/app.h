@@ -7,32 +7,197 @@
 #define BLBENCH_APP_H
 
 #include "backend.h"
+#include "cache_evict.h"
+#include "calibration_cache.h"
 #include "cmdline.h"
+#include "image_diff.h"
 #include "jsonbuilder.h"
+#include "perf_counters.h"
+#include "record_writer.h"
+#include "stats.h"
 
 #include <blend2d.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace blbench {
 
+//! Result of a single test of a single size, see `BenchApp::run_single_test()`.
+struct TestResult {
+  //! Render calls per run.
+  uint32_t quantity;
+  //! The best duration [us].
+  uint64_t duration;
+  //! Statistics of all samples [calls per millisecond].
+  SampleStats stats;
+  //! Hardware performance counters of the run that had the best duration.
+  PerfCounterValues counters;
+  //! Latencies of individual render calls of all runs [ns] (only used by latency mode).
+  LatencyHistogram latency;
+  //! Heap allocations and peak RSS growth of the run that had the best duration.
+  AllocCounters allocs;
+  //! Shape size of the test.
+  uint32_t shape_size;
+  //! True if the test was aborted by `--time-budget` before it finished its repeats.
+  bool over_budget;
+  //! True if the rendered image was compared with the reference (only used by `--verify`).
+  bool verified;
+  //! Difference between the rendered image and the reference image.
+  ImageDiff diff;
+};
+
+//! Results of all tests run by a single backend [calls per millisecond], zero if the test was not run.
+struct BackendResults {
+  //! Backend name.
+  std::string name;
+  std::vector<double> cpms;
+
+  static inline size_t index_of(uint32_t comp_op, uint32_t style, uint32_t test, uint32_t size) {
+    return ((size_t(comp_op) * kStyleKindCount + style) * kTestKindCount + test) * kBenchShapeSizeCount + size;
+  }
+
+  inline void reset() { cpms.assign(size_t(kCompOpCount) * kStyleKindCount * kTestKindCount * kBenchShapeSizeCount, 0.0); }
+
+  inline double get(uint32_t comp_op, uint32_t style, uint32_t test, uint32_t size) const {
+    return cpms.empty() ? 0.0 : cpms[index_of(comp_op, style, test, size)];
+  }
+
+  inline void set(uint32_t comp_op, uint32_t style, uint32_t test, uint32_t size, double value) {
+    cpms[index_of(comp_op, style, test, size)] = value;
+  }
+};
+
+//! Spreads `--time-budget` across tests that remain to be run, see `BenchApp::run_single_test()`.
+//!
+//! Each test gets an equal share of the remaining budget, thus time not used by fast tests is given to the tests
+//! that follow.
+struct TimeBudget {
+  using Clock = std::chrono::steady_clock;
+
+  //! Total budget [s] (0 = unlimited).
+  double seconds = 0.0;
+  //! Number of tests that remain to be run.
+  uint64_t tests_left = 0;
+  //! Number of tests that were aborted before finishing their repeats.
+  uint64_t over_budget_count = 0;
+  Clock::time_point start_time {};
+
+  inline bool enabled() const { return seconds > 0.0; }
+  inline double elapsed() const { return std::chrono::duration<double>(Clock::now() - start_time).count(); }
+
+  inline void start(uint64_t test_count) {
+    tests_left = test_count;
+    over_budget_count = 0;
+    start_time = Clock::now();
+  }
+
+  inline void skip(uint64_t test_count) { tests_left -= std::min(tests_left, test_count); }
+
+  //! Returns the share of the remaining budget [s] of the next test.
+  inline double next_share() {
+    double remaining = std::max(seconds - elapsed(), 0.0);
+    double share = remaining / double(tests_left ? tests_left : uint64_t(1));
+    skip(1);
+    return share;
+  }
+};
+
+//! Configuration of a soak run (`--soak`), which renders a single test for a fixed wall time.
+struct SoakConfig {
+  TestKind test;
+  StyleKind style;
+  uint32_t shape_size;
+  //! Wall time [s] (0 = soak mode disabled).
+  double seconds;
+};
+
 struct BenchApp {
   CmdLine _cmd_line;
 
   // Configuration.
   uint32_t _width = 512;
   uint32_t _height = 600;
+  //! Canvas sizes to benchmark (either from --canvas or a single --width x --height canvas).
+  std::vector<BLSizeI> _canvases;
+  //! Pixel formats of the canvas to benchmark.
+  std::vector<BLFormat> _formats {BL_FORMAT_PRGB32};
+  //! Stroke options to benchmark - options other than the default only run stroke tests of polygons and shapes.
+  std::vector<StrokeKind> _strokes {StrokeKind::kDefault};
+  //! Path modes to benchmark - modes other than replay only run shape tests.
+  std::vector<ShapePathMode> _shape_paths {ShapePathMode::kReplay};
   uint32_t _comp_op = 0xFFFFFFFF;
   uint32_t _size_count = kBenchShapeSizeCount;
+  //! Shape sizes to benchmark (`_size_count` sizes selected by --size-count or --sizes).
+  uint32_t _shape_sizes[kBenchShapeSizeCount] {};
+  //! Tests to benchmark (bit per `TestKind`).
+  uint64_t _test_mask = ~uint64_t(0);
+  //! Styles to benchmark (bit per `StyleKind`, 0 = default, which depends on --deep).
+  uint32_t _style_mask = 0;
   uint32_t _quantity = 0;
   uint32_t _repeat = 1;
+  uint32_t _max_repeat = 100;
+  //! Minimum duration of a single run when calibrating the quantity [us].
+  uint32_t _target_duration = 1000;
   uint32_t _backends = 0xFFFFFFFF;
+  WorkloadMode _workload_mode = WorkloadMode::kInline;
+
+  //! Thread counts of Blend2D backends (0 means a synchronous single-threaded context).
+  std::vector<uint32_t> _thread_counts {0, 2, 4};
+  //! Number of independent single-threaded Blend2D backends rendering concurrently (0 = render farm disabled).
+  uint32_t _farm = 0;
+  //! Name of the backend all other backends are compared to (nullptr = speedup matrix disabled).
+  const char* _baseline_backend = nullptr;
+
+  //! Target width of the median confidence interval relative to the median [%] (0 = disabled).
+  double _ci = 0.0;
+  //! Time budget of the whole run (`--time-budget`).
+  TimeBudget _time_budget;
+
+  //! Soak mode configuration (`--soak`).
+  SoakConfig _soak {};
+  //! Use Blend2D without JIT compiled pipelines in soak mode, so profilers can symbolize all pipeline code.
+  bool _soak_no_jit = false;
+  //! Control FIFO of `perf record/stat --control=fifo:<file>`, which is enabled only while soaking.
+  const char* _perf_ctl_file = nullptr;
 
   bool _save_images = false;
   bool _save_overview = false;
   bool _isolated = false;
   bool _deep_bench = false;
+  bool _perf_counters = false;
+  bool _latency = false;
+  bool _subtract_overhead = false;
+  bool _alloc_stats = false;
+  bool _verify = false;
+  bool _cold = false;
+
+  //! True while tests are measured with cold caches (only used by `--cold` mode).
+  bool _cold_pass = false;
+  //! Evicts caches before each render call of the cold pass.
+  CacheEvictor _cache_evictor;
+
+  //! PSNR [dB] below which a verified test is reported as an outlier.
+  double _verify_psnr = 30.0;
+  //! Number of verified tests reported as outliers.
+  uint64_t _verify_outliers = 0;
+
+  //! File where test records are streamed as JSON lines (nullptr = disabled), see `RecordWriter`.
+  const char* _output_file = nullptr;
+  //! Synchronize `_output_file` to the storage after each record.
+  bool _fsync = false;
+  mutable RecordWriter _record_writer;
+
+  //! File where calibrated quantities are persisted (nullptr = disabled), see `CalibrationCache`.
+  const char* _calibration_file = nullptr;
+  CalibrationCache _calibration_cache;
+
+  //! Harness overhead per render call [us] measured by the null backend - indexed as [style][test][size].
+  double _overhead[kStyleKindCount][kTestKindCount][kBenchShapeSizeCount] {};
 
   // Assets.
   using SpriteData = std::array<BLImage, 4>;
@@ -57,14 +222,32 @@ struct BenchApp {
 
   bool is_backend_enabled(BackendKind backend_kind) const;
   bool is_style_enabled(StyleKind style) const;
+  bool is_test_enabled(TestKind test, StrokeKind stroke = StrokeKind::kDefault, ShapePathMode shape_path = ShapePathMode::kReplay) const;
+  bool is_verify_outlier(const ImageDiff& diff) const;
+  void evict_caches(const Backend& backend) const;
+  uint32_t enabled_style_count() const;
+  uint32_t enabled_test_count(StrokeKind stroke = StrokeKind::kDefault, ShapePathMode shape_path = ShapePathMode::kReplay) const;
+  uint64_t count_tests() const;
+
+  void print_table_header(const char* name) const;
 
   void serialize_system_info(JSONBuilder& json) const;
   void serialize_params(JSONBuilder& json, const BenchParams& params) const;
   void serialize_options(JSONBuilder& json, const BenchParams& params) const;
 
+  std::string calibration_fingerprint() const;
+  std::string calibration_key(const Backend& backend, const BenchParams& params) const;
+  void save_calibration_cache();
+
   int run();
-  int run_backend_tests(Backend& backend, BenchParams& params, JSONBuilder& json);
-  uint64_t run_single_test(Backend& backend, BenchParams& params);
+  int run_soak();
+  int run_backend_tests(Backend& backend, BenchParams& params, JSONBuilder& json, BackendResults* results_out = nullptr);
+  void run_canvas_tests(BenchParams& params, JSONBuilder& json);
+  void report_scaling(JSONBuilder& json, const BenchParams& params, const std::vector<BackendResults>& results) const;
+  void report_speedup(JSONBuilder& json, const BenchParams& params, const std::vector<BackendResults>& results) const;
+  int run_farm_tests(BenchParams& params, JSONBuilder& json);
+  void run_single_test(Backend& backend, BenchParams& params, TestResult& result, uint32_t fixed_quantity = 0);
+  void stream_record(const char* run_name, const BenchParams& params, const JSONBuilder& json, size_t record_start) const;
 };
 
 } // {blbench}
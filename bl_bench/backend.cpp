@@ -8,9 +8,32 @@
 #include "shape_data.h"
 
 #include <chrono>
+#include <math.h>
 
 namespace blbench {
 
+// blbench::StrokeOptions
+// ======================
+
+static const StrokeOptions stroke_options_table[kStrokeKindCount] = {
+  {  1.0, true , StrokeJoin::kMiter, StrokeCap::kButt  ,  0.0,  0.0 }, // kHairline
+  {  1.0, false, StrokeJoin::kMiter, StrokeCap::kButt  ,  0.0,  0.0 }, // kWidth1
+  {  2.0, false, StrokeJoin::kMiter, StrokeCap::kButt  ,  0.0,  0.0 }, // kWidth2
+  {  8.0, false, StrokeJoin::kMiter, StrokeCap::kButt  ,  0.0,  0.0 }, // kWidth8
+  { 32.0, false, StrokeJoin::kMiter, StrokeCap::kButt  ,  0.0,  0.0 }, // kWidth32
+  {  8.0, false, StrokeJoin::kRound, StrokeCap::kButt  ,  0.0,  0.0 }, // kRoundJoin8
+  {  8.0, false, StrokeJoin::kBevel, StrokeCap::kButt  ,  0.0,  0.0 }, // kBevelJoin8
+  { 32.0, false, StrokeJoin::kRound, StrokeCap::kButt  ,  0.0,  0.0 }, // kRoundJoin32
+  {  2.0, false, StrokeJoin::kMiter, StrokeCap::kButt  ,  8.0,  4.0 }, // kDash2
+  {  8.0, false, StrokeJoin::kMiter, StrokeCap::kButt  , 24.0, 16.0 }, // kDashButtCap8
+  {  8.0, false, StrokeJoin::kMiter, StrokeCap::kRound , 24.0, 16.0 }, // kDashRoundCap8
+  {  8.0, false, StrokeJoin::kMiter, StrokeCap::kSquare, 24.0, 16.0 }  // kDashSquareCap8
+};
+
+const StrokeOptions& stroke_options_of(StrokeKind stroke) {
+  return stroke_options_table[uint32_t(stroke)];
+}
+
 // blbench::Backend - Construction & Destruction
 // =================================================
 
@@ -33,6 +56,103 @@ static void BenchModule_shape_helper(Backend* mod, RenderOp op, ShapeKind shapeK
   mod->render_shape(op, shapeData);
 }
 
+// Fills `_workload` with the same values the render loop would generate - the number of coordinates consumed per
+// render call depends on the test, colors and radii are generated for the worst case (gradients consume 3 colors).
+void Backend::generate_workload() {
+  uint32_t quantity = _params.quantity;
+  uint32_t complexity = 0;
+  bool uses_radius = false;
+
+  switch (_params.testKind) {
+    case TestKind::kFillSmoothRound   :
+    case TestKind::kFillRotatedRound  :
+    case TestKind::kStrokeSmoothRound :
+    case TestKind::kStrokeRotatedRound: uses_radius = true; break;
+    case TestKind::kFillTriangle      :
+    case TestKind::kStrokeTriangle    : complexity = 3; break;
+    case TestKind::kFillPolygon10NZ   :
+    case TestKind::kFillPolygon10EO   :
+    case TestKind::kStrokePolygon10   : complexity = 10; break;
+    case TestKind::kFillPolygon20NZ   :
+    case TestKind::kFillPolygon20EO   :
+    case TestKind::kStrokePolygon20   : complexity = 20; break;
+    case TestKind::kFillPolygon40NZ   :
+    case TestKind::kFillPolygon40EO   :
+    case TestKind::kStrokePolygon40   : complexity = 40; break;
+    case TestKind::kFillPolygon1KNZ   :
+    case TestKind::kStrokePolygon1K   : complexity = 1000; break;
+    case TestKind::kFillPolygon10KNZ  :
+    case TestKind::kStrokePolygon10K  : complexity = 10000; break;
+    case TestKind::kFillPolygon100KNZ :
+    case TestKind::kStrokePolygon100K : complexity = 100000; break;
+
+    default:
+      break;
+  }
+
+  // Rectangles use [0, screen - size) range for their origin, which is the same range used by shape base points.
+  double wh = double(_params.shape_size);
+  double max_x = double(_params.screen_w) - wh;
+  double max_y = double(_params.screen_h) - wh;
+
+  _workload.clear();
+  _workload.origins.resize(size_t(quantity) * 2u);
+  _workload.vertices.resize(size_t(quantity) * complexity * 2u);
+  _workload.colors.resize(size_t(quantity) * 3u);
+  _workload.radii.resize(uses_radius ? size_t(quantity) : size_t(0));
+
+  double* origins = _workload.origins.data();
+  double* vertices = _workload.vertices.data();
+
+  for (uint32_t i = 0; i < quantity; i++) {
+    double x = _rnd_coord.next_double(0.0, max_x);
+    double y = _rnd_coord.next_double(0.0, max_y);
+
+    *origins++ = x;
+    *origins++ = y;
+
+    for (uint32_t p = 0; p < complexity; p++) {
+      *vertices++ = _rnd_coord.next_double(x, x + wh);
+      *vertices++ = _rnd_coord.next_double(y, y + wh);
+    }
+  }
+
+  for (uint32_t& color : _workload.colors)
+    color = _rnd_color.next_rgba32().value;
+
+  for (double& radius : _workload.radii)
+    radius = _rnd_extra.next_double(4.0, 40.0);
+}
+
+// Star vertices don't depend on random inputs, thus they are generated once per run and only translated by render
+// calls. Spikes of stars having many vertices are thinner than a pixel, which stresses building of edges.
+void Backend::generate_star(uint32_t complexity) {
+  double r = double(_params.shape_size) * 0.5;
+
+  _star_vertices.resize(complexity);
+  for (uint32_t i = 0; i < complexity; i++) {
+    double angle = double(i) * (6.283185307179586 / double(complexity));
+    double radius = (i & 1u) ? r * 0.4 : r;
+    _star_vertices[i].reset(r + cos(angle) * radius, r + sin(angle) * radius);
+  }
+}
+
+void Backend::generate_gradient_colors(uint32_t stop_count) {
+  _gradient_colors.resize(stop_count);
+  for (BLRgba32& color : _gradient_colors)
+    color = _rnd_color.next_rgba32();
+}
+
+// Cached paths are built by `before_run()`, thus their origins must be known before the measurement. Origins are
+// generated the same way as by the render loop of other path modes, but at most `kBenchMaxCachedShapes` of them.
+void Backend::generate_cached_shape_origins() {
+  BLSizeI bounds(_params.screen_w - _params.shape_size, _params.screen_h - _params.shape_size);
+
+  _cached_shape_origins.resize(std::min<uint32_t>(_params.quantity, kBenchMaxCachedShapes));
+  for (BLPoint& origin : _cached_shape_origins)
+    origin = next_origin(bounds);
+}
+
 void Backend::run(const BenchApp& app, const BenchParams& params) {
   _params = params;
 
@@ -40,14 +160,121 @@ void Backend::run(const BenchApp& app, const BenchParams& params) {
   _rnd_color.rewind();
   _rnd_extra.rewind();
   _rnd_sprite_id = 0;
+  _rotation_angle = 0.0;
+
+  // Gradient stop colors are taken before the workload, thus both workload modes render the same stops.
+  if (is_gradient_stop_test(_params.testKind))
+    generate_gradient_colors(gradient_stop_count_of(_params.testKind));
+  else
+    _gradient_colors.clear();
+
+  _workload.enabled = app._workload_mode == WorkloadMode::kPregenerated;
+  if (_workload.enabled)
+    generate_workload();
+
+  switch (_params.testKind) {
+    case TestKind::kFillStar1K  : generate_star(1000); break;
+    case TestKind::kFillStar10K : generate_star(10000); break;
+    case TestKind::kFillStar100K: generate_star(100000); break;
+
+    default:
+      _star_vertices.clear();
+      break;
+  }
+
+  ShapeKind shape_kind;
+  _cached_shape_index = 0;
+
+  if (shape_kind_of(_params.testKind, shape_kind))
+    get_shape_data(_cached_shape, shape_kind);
+  else
+    _cached_shape = ShapeData{};
+
+  if (_params.shape_path == ShapePathMode::kCached && is_shape_test(_params.testKind))
+    generate_cached_shape_origins();
+  else
+    _cached_shape_origins.clear();
 
   // Initialize the sprites.
   for (uint32_t i = 0; i < kBenchNumSprites; i++) {
-    _sprites[i] = app.get_scaled_sprite(i, params.shape_size);
+    _sprites[i] = app.get_scaled_sprite(i, sprite_size_of(params.testKind, params.shape_size));
   }
 
   before_run();
+
+  if (app._latency)
+    _latency.reset();
+
+  if (app._alloc_stats)
+    _alloc_tracker.start();
+
+  bool use_perf_counters = app._perf_counters && _perf.open();
+  if (use_perf_counters)
+    _perf.start();
+
   auto start = std::chrono::high_resolution_clock::now();
+  uint64_t cold_ticks = 0;
+
+  if (app._cold_pass) {
+    // Caches are evicted before each render call, which is not measured, thus each call starts cold. Tests that
+    // amortize work across items render all items by a single call, otherwise each call renders 1 item.
+    uint32_t quantity = _params.quantity;
+    uint32_t call_count = is_amortized_test(_params.testKind) ? 1u : quantity;
+
+    _params.quantity = quantity / call_count;
+
+    for (uint32_t i = 0; i < call_count; i++) {
+      app.evict_caches(*this);
+
+      uint64_t call_start = LatencyTimer::now();
+      render_test();
+      flush();
+      cold_ticks += LatencyTimer::now() - call_start;
+    }
+
+    _params.quantity = quantity;
+  }
+  else if (app._latency) {
+    // Each render call is measured separately, thus the test is rendered in `quantity` calls, each rendering 1 item.
+    uint32_t quantity = _params.quantity;
+    _params.quantity = 1;
+
+    for (uint32_t i = 0; i < quantity; i++) {
+      uint64_t call_start = LatencyTimer::now();
+      render_test();
+      uint64_t call_end = LatencyTimer::now();
+      _latency.record(LatencyTimer::ticks_to_ns(call_end - call_start));
+    }
+
+    _params.quantity = quantity;
+  }
+  else {
+    render_test();
+  }
+
+  flush();
+
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (use_perf_counters)
+    _perf.stop(_counters);
+  else
+    _counters.reset();
+
+  if (app._alloc_stats)
+    _alloc_tracker.stop(_allocs);
+  else
+    _allocs.reset();
+
+  std::chrono::duration<double> elapsed = end - start;
+  _duration = app._cold_pass ? (LatencyTimer::ticks_to_ns(cold_ticks) + 500u) / 1000u
+                             : uint64_t(elapsed.count() * 1000000);
+
+  after_run();
+}
+
+void Backend::render_test() {
+  int wh = int(_params.shape_size);
 
   switch (_params.testKind) {
     case TestKind::kFillAlignedRect   : render_rect_a(RenderOp::kFillNonZero); break;
@@ -55,40 +282,66 @@ void Backend::run(const BenchApp& app, const BenchParams& params) {
     case TestKind::kFillRotatedRect   : render_rect_rotated(RenderOp::kFillNonZero); break;
     case TestKind::kFillSmoothRound   : render_round_f(RenderOp::kFillNonZero); break;
     case TestKind::kFillRotatedRound  : render_round_rotated(RenderOp::kFillNonZero); break;
-    case TestKind::kFillTriangle      : render_polygon(RenderOp::kFillNonZero, 3); break;
-    case TestKind::kFillPolygon10NZ   : render_polygon(RenderOp::kFillNonZero, 10); break;
-    case TestKind::kFillPolygon10EO   : render_polygon(RenderOp::kFillEvenOdd, 10); break;
-    case TestKind::kFillPolygon20NZ   : render_polygon(RenderOp::kFillNonZero, 20); break;
-    case TestKind::kFillPolygon20EO   : render_polygon(RenderOp::kFillEvenOdd, 20); break;
-    case TestKind::kFillPolygon40NZ   : render_polygon(RenderOp::kFillNonZero, 40); break;
-    case TestKind::kFillPolygon40EO   : render_polygon(RenderOp::kFillEvenOdd, 40); break;
+    case TestKind::kFillTriangle      : render_polygon(RenderOp::kFillNonZero, PolygonKind::kRandom, 3); break;
+    case TestKind::kFillPolygon10NZ   : render_polygon(RenderOp::kFillNonZero, PolygonKind::kRandom, 10); break;
+    case TestKind::kFillPolygon10EO   : render_polygon(RenderOp::kFillEvenOdd, PolygonKind::kRandom, 10); break;
+    case TestKind::kFillPolygon20NZ   : render_polygon(RenderOp::kFillNonZero, PolygonKind::kRandom, 20); break;
+    case TestKind::kFillPolygon20EO   : render_polygon(RenderOp::kFillEvenOdd, PolygonKind::kRandom, 20); break;
+    case TestKind::kFillPolygon40NZ   : render_polygon(RenderOp::kFillNonZero, PolygonKind::kRandom, 40); break;
+    case TestKind::kFillPolygon40EO   : render_polygon(RenderOp::kFillEvenOdd, PolygonKind::kRandom, 40); break;
+    case TestKind::kFillPolygon1KNZ   : render_polygon(RenderOp::kFillNonZero, PolygonKind::kRandom, 1000); break;
+    case TestKind::kFillPolygon10KNZ  : render_polygon(RenderOp::kFillNonZero, PolygonKind::kRandom, 10000); break;
+    case TestKind::kFillPolygon100KNZ : render_polygon(RenderOp::kFillNonZero, PolygonKind::kRandom, 100000); break;
+    case TestKind::kFillStar1K        : render_polygon(RenderOp::kFillNonZero, PolygonKind::kStar, 1000); break;
+    case TestKind::kFillStar10K       : render_polygon(RenderOp::kFillNonZero, PolygonKind::kStar, 10000); break;
+    case TestKind::kFillStar100K      : render_polygon(RenderOp::kFillNonZero, PolygonKind::kStar, 100000); break;
     case TestKind::kFillButterfly     : BenchModule_shape_helper(this, RenderOp::kFillNonZero, ShapeKind::kButterfly); break;
     case TestKind::kFillFish          : BenchModule_shape_helper(this, RenderOp::kFillNonZero, ShapeKind::kFish); break;
     case TestKind::kFillDragon        : BenchModule_shape_helper(this, RenderOp::kFillNonZero, ShapeKind::kDragon); break;
     case TestKind::kFillWorld         : BenchModule_shape_helper(this, RenderOp::kFillNonZero, ShapeKind::kWorld); break;
+    case TestKind::kFillAlignedRectBatch: render_rect_a_batch(RenderOp::kFillNonZero); break;
+    case TestKind::kFillSmoothRectBatch: render_rect_f_batch(RenderOp::kFillNonZero); break;
+    case TestKind::kFillTextLabel     : render_text(TextKind::kLabel); break;
+    case TestKind::kFillTextParagraph : render_text(TextKind::kParagraph); break;
+    case TestKind::kFillGlyphRun      : render_text(TextKind::kGlyphRun); break;
+
+    case TestKind::kBlitScaleUp       : render_blit_scaled(BLSizeI(wh, wh), false); break;
+    case TestKind::kBlitScaleDown     : render_blit_scaled(BLSizeI(wh, wh), false); break;
+    case TestKind::kBlitScaleNonUniform: render_blit_scaled(BLSizeI(wh + wh / 2, std::max(wh / 2, 1)), false); break;
+    case TestKind::kBlitFractional    : render_blit_scaled(BLSizeI(wh, wh), true); break;
+
+    case TestKind::kFillClipStatic    : render_rect_clip(ClipMode::kStatic); break;
+    case TestKind::kFillClipNested    : render_rect_clip(ClipMode::kNested); break;
+    case TestKind::kFillClipPerCall   : render_rect_clip(ClipMode::kPerCall); break;
+
+    case TestKind::kFillGradientStops2  : render_gradient_stops(2, false); break;
+    case TestKind::kFillGradientStops8  : render_gradient_stops(8, false); break;
+    case TestKind::kFillGradientStops32 : render_gradient_stops(32, false); break;
+    case TestKind::kFillGradientStops256: render_gradient_stops(256, false); break;
+    case TestKind::kFillGradientReuse2  : render_gradient_stops(2, true); break;
+    case TestKind::kFillGradientReuse8  : render_gradient_stops(8, true); break;
+    case TestKind::kFillGradientReuse32 : render_gradient_stops(32, true); break;
+    case TestKind::kFillGradientReuse256: render_gradient_stops(256, true); break;
 
     case TestKind::kStrokeAlignedRect : render_rect_a(RenderOp::kStroke); break;
     case TestKind::kStrokeSmoothRect  : render_rect_f(RenderOp::kStroke); break;
     case TestKind::kStrokeRotatedRect : render_rect_rotated(RenderOp::kStroke); break;
     case TestKind::kStrokeSmoothRound : render_round_f(RenderOp::kStroke); break;
     case TestKind::kStrokeRotatedRound: render_round_rotated(RenderOp::kStroke); break;
-    case TestKind::kStrokeTriangle    : render_polygon(RenderOp::kStroke, 3); break;
-    case TestKind::kStrokePolygon10   : render_polygon(RenderOp::kStroke, 10); break;
-    case TestKind::kStrokePolygon20   : render_polygon(RenderOp::kStroke, 20); break;
-    case TestKind::kStrokePolygon40   : render_polygon(RenderOp::kStroke, 40); break;
+    case TestKind::kStrokeTriangle    : render_polygon(RenderOp::kStroke, PolygonKind::kRandom, 3); break;
+    case TestKind::kStrokePolygon10   : render_polygon(RenderOp::kStroke, PolygonKind::kRandom, 10); break;
+    case TestKind::kStrokePolygon20   : render_polygon(RenderOp::kStroke, PolygonKind::kRandom, 20); break;
+    case TestKind::kStrokePolygon40   : render_polygon(RenderOp::kStroke, PolygonKind::kRandom, 40); break;
+    case TestKind::kStrokePolygon1K   : render_polygon(RenderOp::kStroke, PolygonKind::kRandom, 1000); break;
+    case TestKind::kStrokePolygon10K  : render_polygon(RenderOp::kStroke, PolygonKind::kRandom, 10000); break;
+    case TestKind::kStrokePolygon100K : render_polygon(RenderOp::kStroke, PolygonKind::kRandom, 100000); break;
     case TestKind::kStrokeButterfly   : BenchModule_shape_helper(this, RenderOp::kStroke, ShapeKind::kButterfly); break;
     case TestKind::kStrokeFish        : BenchModule_shape_helper(this, RenderOp::kStroke, ShapeKind::kFish); break;
     case TestKind::kStrokeDragon      : BenchModule_shape_helper(this, RenderOp::kStroke, ShapeKind::kDragon); break;
     case TestKind::kStrokeWorld       : BenchModule_shape_helper(this, RenderOp::kStroke, ShapeKind::kWorld); break;
+    case TestKind::kStrokeAlignedRectBatch: render_rect_a_batch(RenderOp::kStroke); break;
+    case TestKind::kStrokeSmoothRectBatch: render_rect_f_batch(RenderOp::kStroke); break;
   }
-
-  flush();
-
-  auto end = std::chrono::high_resolution_clock::now();
-  std::chrono::duration<double> elapsed = end - start;
-  _duration = uint64_t(elapsed.count() * 1000000);
-
-  after_run();
 }
 
 void Backend::serialize_info(JSONBuilder& json) const { (void)json; }
@@ -8,9 +8,16 @@
 
 #include <blend2d.h>
 
+#include "alloc_stats.h"
 #include "jsonbuilder.h"
 #include "backend.h"
+#include "latency.h"
+#include "perf_counters.h"
 #include "shape_data.h"
+#include "text_data.h"
+
+#include <algorithm>
+#include <vector>
 
 namespace blbench {
 
@@ -27,8 +34,9 @@ enum class BackendKind : uint32_t {
   kSkia,
   kJUCE,
   kCoreGraphics,
+  kNull,
 
-  kMaxValue = kCoreGraphics
+  kMaxValue = kNull
 };
 
 enum class TestKind : uint32_t {
@@ -44,10 +52,39 @@ enum class TestKind : uint32_t {
   kFillPolygon20EO,
   kFillPolygon40NZ,
   kFillPolygon40EO,
+  kFillPolygon1KNZ,
+  kFillPolygon10KNZ,
+  kFillPolygon100KNZ,
+  kFillStar1K,
+  kFillStar10K,
+  kFillStar100K,
   kFillButterfly,
   kFillFish,
   kFillDragon,
   kFillWorld,
+  kFillAlignedRectBatch,
+  kFillSmoothRectBatch,
+  kFillTextLabel,
+  kFillTextParagraph,
+  kFillGlyphRun,
+
+  kBlitScaleUp,
+  kBlitScaleDown,
+  kBlitScaleNonUniform,
+  kBlitFractional,
+
+  kFillClipStatic,
+  kFillClipNested,
+  kFillClipPerCall,
+
+  kFillGradientStops2,
+  kFillGradientStops8,
+  kFillGradientStops32,
+  kFillGradientStops256,
+  kFillGradientReuse2,
+  kFillGradientReuse8,
+  kFillGradientReuse32,
+  kFillGradientReuse256,
 
   kStrokeAlignedRect,
   kStrokeSmoothRect,
@@ -58,12 +95,17 @@ enum class TestKind : uint32_t {
   kStrokePolygon10,
   kStrokePolygon20,
   kStrokePolygon40,
+  kStrokePolygon1K,
+  kStrokePolygon10K,
+  kStrokePolygon100K,
   kStrokeButterfly,
   kStrokeFish,
   kStrokeDragon,
   kStrokeWorld,
+  kStrokeAlignedRectBatch,
+  kStrokeSmoothRectBatch,
 
-  kMaxValue = kStrokeWorld
+  kMaxValue = kStrokeSmoothRectBatch
 };
 
 enum class StyleKind : uint32_t {
@@ -81,17 +123,295 @@ enum class StyleKind : uint32_t {
   kMaxValue = kPatternBI
 };
 
+enum class WorkloadMode : uint32_t {
+  //! Random inputs are generated by the render loop (part of the measured time).
+  kInline,
+  //! Random inputs are generated into `Workload` buffers before the measurement starts.
+  kPregenerated,
+
+  kMaxValue = kPregenerated
+};
+
 enum class RenderOp : uint32_t {
   kFillNonZero,
   kFillEvenOdd,
   kStroke
 };
 
+enum class PolygonKind : uint32_t {
+  //! Vertices are random points within the shape rectangle, thus edges intersect each other.
+  kRandom,
+  //! Vertices alternate between the outer and inner circle of a star inscribed to the shape rectangle.
+  kStar
+};
+
+enum class StrokeKind : uint32_t {
+  kHairline,
+  kWidth1,
+  kWidth2,
+  kWidth8,
+  kWidth32,
+  kRoundJoin8,
+  kBevelJoin8,
+  kRoundJoin32,
+  kDash2,
+  kDashButtCap8,
+  kDashRoundCap8,
+  kDashSquareCap8,
+
+  kDefault = kWidth2,
+  kMaxValue = kDashSquareCap8
+};
+
+enum class ShapePathMode : uint32_t {
+  //! The path of a shape is built once before the measurement and each render call draws it translated to a random
+  //! origin.
+  kReplay,
+  //! The path of a shape is rebuilt from `ShapeIterator` at a random origin by each render call, thus the measured
+  //! time includes path construction.
+  kRebuild,
+  //! Paths of a shape are built at random origins before the measurement (see `Backend::_cached_shape_origins`), thus
+  //! each render call draws a path that needs no translation.
+  kCached,
+
+  kMaxValue = kCached
+};
+
+enum class StrokeJoin : uint32_t {
+  kMiter,
+  kRound,
+  kBevel
+};
+
+enum class StrokeCap : uint32_t {
+  kButt,
+  kRound,
+  kSquare
+};
+
+enum class ClipMode : uint32_t {
+  //! A single clip rectangle is active during the whole test, see `Backend::static_clip_rect()`.
+  kStatic,
+  //! Each render call is clipped by two nested save/clip/restore scopes, see `clip_outer_rect()`.
+  kNested,
+  //! Each render call replaces the clip rectangle, see `clip_call_rect()`.
+  kPerCall
+};
+
 static constexpr uint32_t kBackendKindCount = uint32_t(BackendKind::kMaxValue) + 1;
 static constexpr uint32_t kTestKindCount = uint32_t(TestKind::kMaxValue) + 1;
 static constexpr uint32_t kStyleKindCount = uint32_t(StyleKind::kMaxValue) + 1;
+static constexpr uint32_t kCompOpCount = uint32_t(BL_COMP_OP_MAX_VALUE) + 1;
+static constexpr uint32_t kWorkloadModeCount = uint32_t(WorkloadMode::kMaxValue) + 1;
+static constexpr uint32_t kStrokeKindCount = uint32_t(StrokeKind::kMaxValue) + 1;
+static constexpr uint32_t kShapePathModeCount = uint32_t(ShapePathMode::kMaxValue) + 1;
 static constexpr uint32_t kBenchNumSprites = 4;
 static constexpr uint32_t kBenchShapeSizeCount = 6;
+//! Number of rectangles submitted by a single render call of batched tests (the last batch can be smaller).
+static constexpr uint32_t kBenchBatchSize = 256;
+//! Maximum number of paths built by `ShapePathMode::kCached` - render calls cycle through them if the quantity is greater.
+static constexpr uint32_t kBenchMaxCachedShapes = 1024;
+//! Maximum number of stops of gradient stop tests, see `gradient_stop_count_of()`.
+static constexpr uint32_t kBenchMaxGradientStops = 256;
+//! Maximum number of render calls of the cold pass of `--cold` - caches are evicted before each call, which is
+//! expensive, thus the cold pass renders at most this many calls instead of the calibrated quantity.
+static constexpr uint32_t kBenchColdQuantity = 32;
+//! Maximum number of polygon vertices backends store on the stack - high vertex-count polygons use a buffer sized by
+//! `before_run()`, see `vertices_per_call()`.
+static constexpr uint32_t kBenchMaxStackVertices = 128;
+//! Miter limit of all strokes (the ratio of the miter length to the stroke width, as used by SVG).
+static constexpr double kBenchMiterLimit = 4.0;
+
+//! Tests that render text, which is not supported by all backends, see `Backend::supports_test()`.
+static inline bool is_text_test(TestKind test) {
+  return test == TestKind::kFillTextLabel || test == TestKind::kFillTextParagraph || test == TestKind::kFillGlyphRun;
+}
+
+//! Tests that blit a sprite scaled to a destination rectangle, see `Backend::render_blit_scaled()`.
+static inline bool is_blit_test(TestKind test) {
+  return test == TestKind::kBlitScaleUp          ||
+         test == TestKind::kBlitScaleDown        ||
+         test == TestKind::kBlitScaleNonUniform  ||
+         test == TestKind::kBlitFractional       ;
+}
+
+//! Returns the number of stops of a gradient stop test, or zero if `test` is not a gradient stop test, see
+//! `Backend::render_gradient_stops()`.
+static inline uint32_t gradient_stop_count_of(TestKind test) {
+  switch (test) {
+    case TestKind::kFillGradientStops2  : return 2;
+    case TestKind::kFillGradientStops8  : return 8;
+    case TestKind::kFillGradientStops32 : return 32;
+    case TestKind::kFillGradientStops256: return 256;
+    case TestKind::kFillGradientReuse2  : return 2;
+    case TestKind::kFillGradientReuse8  : return 8;
+    case TestKind::kFillGradientReuse32 : return 32;
+    case TestKind::kFillGradientReuse256: return 256;
+
+    default:
+      return 0;
+  }
+}
+
+//! Tests that fill rectangles with gradients of many stops, which are not supported by all backends.
+static inline bool is_gradient_stop_test(TestKind test) {
+  return gradient_stop_count_of(test) != 0;
+}
+
+//! Blit tests only run with pattern styles, which select the quality of the blit (nearest or bilinear), and gradient
+//! stop tests only run with gradient styles, which select the gradient type and extend mode.
+static inline bool is_style_applicable(TestKind test, StyleKind style) {
+  if (is_blit_test(test))
+    return style == StyleKind::kPatternNN || style == StyleKind::kPatternBI;
+
+  if (is_gradient_stop_test(test))
+    return style >= StyleKind::kLinearPad && style <= StyleKind::kConic;
+
+  return true;
+}
+
+//! Tests that amortize work across all items of a run (rectangle batches and reused gradients). `--latency` renders
+//! a single item per call, which would measure a per-call path instead, thus these tests are not run in that mode.
+static inline bool is_amortized_test(TestKind test) {
+  return test == TestKind::kFillAlignedRectBatch   ||
+         test == TestKind::kFillSmoothRectBatch    ||
+         test == TestKind::kStrokeAlignedRectBatch ||
+         test == TestKind::kStrokeSmoothRectBatch  ||
+         test == TestKind::kFillGradientReuse2     ||
+         test == TestKind::kFillGradientReuse8     ||
+         test == TestKind::kFillGradientReuse32    ||
+         test == TestKind::kFillGradientReuse256   ;
+}
+
+//! Returns the offset of a stop at `index` of a gradient having `stop_count` stops, which are evenly distributed.
+static inline double gradient_stop_offset(uint32_t index, uint32_t stop_count) {
+  return double(index) / double(stop_count - 1u);
+}
+
+//! Returns the number of vertices of a polygon rendered by a single render call of a high vertex-count polygon test,
+//! zero if the test is not a high vertex-count polygon test.
+static inline uint32_t vertices_per_call(TestKind test) {
+  switch (test) {
+    case TestKind::kFillPolygon1KNZ   :
+    case TestKind::kFillStar1K        :
+    case TestKind::kStrokePolygon1K   : return 1000;
+    case TestKind::kFillPolygon10KNZ  :
+    case TestKind::kFillStar10K       :
+    case TestKind::kStrokePolygon10K  : return 10000;
+    case TestKind::kFillPolygon100KNZ :
+    case TestKind::kFillStar100K      :
+    case TestKind::kStrokePolygon100K : return 100000;
+
+    default:
+      return 0;
+  }
+}
+
+//! Tests that render strokes of polygons and shapes - the only tests that run with stroke options other than
+//! `StrokeKind::kDefault`.
+static inline bool is_stroke_sweep_test(TestKind test) {
+  return test == TestKind::kStrokeTriangle   ||
+         test == TestKind::kStrokePolygon10  ||
+         test == TestKind::kStrokePolygon20  ||
+         test == TestKind::kStrokePolygon40  ||
+         test == TestKind::kStrokeButterfly  ||
+         test == TestKind::kStrokeFish       ||
+         test == TestKind::kStrokeDragon     ||
+         test == TestKind::kStrokeWorld      ;
+}
+
+static inline bool is_stroke_applicable(TestKind test, StrokeKind stroke) {
+  return stroke == StrokeKind::kDefault || is_stroke_sweep_test(test);
+}
+
+//! Returns the shape rendered by a shape test, or false if `test` is not a shape test.
+static inline bool shape_kind_of(TestKind test, ShapeKind& kind) {
+  switch (test) {
+    case TestKind::kFillButterfly  :
+    case TestKind::kStrokeButterfly: kind = ShapeKind::kButterfly; return true;
+    case TestKind::kFillFish       :
+    case TestKind::kStrokeFish     : kind = ShapeKind::kFish; return true;
+    case TestKind::kFillDragon     :
+    case TestKind::kStrokeDragon   : kind = ShapeKind::kDragon; return true;
+    case TestKind::kFillWorld      :
+    case TestKind::kStrokeWorld    : kind = ShapeKind::kWorld; return true;
+
+    default:
+      return false;
+  }
+}
+
+//! Tests that render shapes - the only tests that run with path modes other than `ShapePathMode::kReplay`.
+static inline bool is_shape_test(TestKind test) {
+  ShapeKind kind;
+  return shape_kind_of(test, kind);
+}
+
+static inline bool is_shape_path_applicable(TestKind test, ShapePathMode shape_path) {
+  return shape_path == ShapePathMode::kReplay || is_shape_test(test);
+}
+
+//! Returns the render operation of a shape test, thus `before_run()` can set the fill rule of paths it builds.
+static inline RenderOp shape_render_op_of(TestKind test) {
+  switch (test) {
+    case TestKind::kStrokeButterfly:
+    case TestKind::kStrokeFish     :
+    case TestKind::kStrokeDragon   :
+    case TestKind::kStrokeWorld    : return RenderOp::kStroke;
+
+    default:
+      return RenderOp::kFillNonZero;
+  }
+}
+
+//! Returns the size of sprites used by a test - sprites are scaled to the shape size except for blit tests that
+//! upscale or downscale them.
+static inline uint32_t sprite_size_of(TestKind test, uint32_t shape_size) {
+  switch (test) {
+    case TestKind::kBlitScaleUp  : return std::max<uint32_t>(shape_size / 2u, 1u);
+    case TestKind::kBlitScaleDown: return shape_size * 2u;
+
+    default:
+      return shape_size;
+  }
+}
+
+//! Returns the outer clip of a render call of `ClipMode::kNested` - `rect` moved by a quarter of its size towards
+//! the bottom-right, which clips away its left and top quarter.
+static inline BLRect clip_outer_rect(const BLRect& rect) {
+  return BLRect(rect.x + rect.w * 0.25, rect.y + rect.h * 0.25, rect.w, rect.h);
+}
+
+//! Returns the inner clip of a render call of `ClipMode::kNested` - the top-left 75% of `rect`, which clips away its
+//! right and bottom quarter.
+static inline BLRect clip_inner_rect(const BLRect& rect) {
+  return BLRect(rect.x, rect.y, rect.w * 0.75, rect.h * 0.75);
+}
+
+//! Returns the clip of a render call of `ClipMode::kPerCall` - the intersection of the outer and inner clip, thus
+//! both clip modes render the same image.
+static inline BLRect clip_call_rect(const BLRect& rect) {
+  return BLRect(rect.x + rect.w * 0.25, rect.y + rect.h * 0.25, rect.w * 0.5, rect.h * 0.5);
+}
+
+// blbench::StrokeOptions
+// ======================
+
+//! Stroke options of a `StrokeKind`.
+struct StrokeOptions {
+  //! Stroke width - hairline strokes use 1.0, which is used as is by backends that have no hairline mode.
+  double width;
+  bool hairline;
+  StrokeJoin join;
+  StrokeCap cap;
+  //! Dash array of a dashed stroke (both zero if the stroke is solid).
+  double dash_on;
+  double dash_off;
+
+  inline bool is_dashed() const { return dash_on > 0.0; }
+};
+
+const StrokeOptions& stroke_options_of(StrokeKind stroke);
 
 // blbench::BenchParams
 // ====================
@@ -108,7 +428,11 @@ struct BenchParams {
   BLCompOp comp_op;
   uint32_t shape_size;
 
+  StrokeKind stroke;
+  //! Stroke width of `stroke` (cached as it's used by most stroke tests).
   double stroke_width;
+
+  ShapePathMode shape_path;
 };
 
 // blbench::BenchRandom
@@ -189,6 +513,44 @@ struct BenchRandom {
   }
 };
 
+// blbench::Workload
+// =================
+
+//! Pre-generated random inputs of a single run (structure of arrays).
+//!
+//! The buffers contain exactly the values that `BenchRandom` would produce in the render loop, so both workload
+//! modes render the same image. Buffers are consumed sequentially by `Backend::next_xxx()` accessors.
+struct Workload {
+  //! Rectangle origins and shape/polygon base points (x, y pairs).
+  std::vector<double> origins;
+  //! Polygon vertex coordinates (x, y pairs).
+  std::vector<double> vertices;
+  //! Colors (up to 3 per render call, which is what gradient styles consume).
+  std::vector<uint32_t> colors;
+  //! Round rectangle radii.
+  std::vector<double> radii;
+
+  size_t origin_index {};
+  size_t vertex_index {};
+  size_t color_index {};
+  size_t radius_index {};
+
+  //! True if the buffers are used instead of random number generators.
+  bool enabled {};
+
+  inline void clear() {
+    origins.clear();
+    vertices.clear();
+    colors.clear();
+    radii.clear();
+
+    origin_index = 0;
+    vertex_index = 0;
+    color_index = 0;
+    radius_index = 0;
+  }
+};
+
 // blbench::Backend
 // ====================
 
@@ -200,6 +562,17 @@ struct Backend {
   //! Current duration.
   uint64_t _duration {};
 
+  //! Hardware performance counters (only used when enabled by the app).
+  PerfCounters _perf;
+  //! Hardware performance counter values of the last run.
+  PerfCounterValues _counters {};
+  //! Latencies of individual render calls of the last run [ns] (only used by latency mode).
+  LatencyHistogram _latency;
+  //! Heap allocation and peak memory tracking (only used when enabled by the app).
+  AllocTracker _alloc_tracker;
+  //! Heap allocations and peak RSS growth of the last run.
+  AllocCounters _allocs {};
+
   //! Random number generator for coordinates (points or rectangles).
   BenchRandom _rnd_coord;
   //! Random number generator for colors.
@@ -208,6 +581,22 @@ struct Backend {
   BenchRandom _rnd_extra;
   //! Random number generator for sprites.
   uint32_t _rnd_sprite_id {};
+  //! Rotation angle of the next item of rotated tests - kept across render calls, as `--latency` renders each item by
+  //! a separate call.
+  double _rotation_angle {};
+
+  //! Pre-generated inputs (only used by `WorkloadMode::kPregenerated`).
+  Workload _workload;
+  //! Vertices of a star polygon relative to its origin - all stars of a run only differ in their origin.
+  std::vector<BLPoint> _star_vertices;
+  //! Stop colors of gradient stop tests - generated once per run, thus reused gradients can be built once.
+  std::vector<BLRgba32> _gradient_colors;
+  //! Shape of paths built by `before_run()` of shape tests (a single path of `ShapePathMode::kReplay`, or a path per
+  //! origin of `ShapePathMode::kCached`), thus paths are kept across render calls, which matters for `--latency`.
+  ShapeData _cached_shape {};
+  std::vector<BLPoint> _cached_shape_origins;
+  //! Index of the cached path to be rendered by the next render call.
+  uint32_t _cached_shape_index {};
 
   //! Blend surface (used by all modules).
   BLImage _surface;
@@ -218,6 +607,11 @@ struct Backend {
   virtual ~Backend();
 
   void run(const BenchApp& app, const BenchParams& params);
+  void render_test();
+  void generate_workload();
+  void generate_star(uint32_t complexity);
+  void generate_gradient_colors(uint32_t stop_count);
+  void generate_cached_shape_origins();
 
   inline const char* name() const { return _name; }
 
@@ -228,10 +622,110 @@ struct Backend {
     return i;
   };
 
+  // Render loop inputs - either generated on the fly or read from pre-generated `_workload`.
+
+  inline BLRect next_rect(const BLSize& bounds, double w, double h) {
+    if (!_workload.enabled)
+      return _rnd_coord.next_rect(bounds, w, h);
+
+    const double* p = _workload.origins.data() + _workload.origin_index;
+    _workload.origin_index += 2;
+    return BLRect(p[0], p[1], w, h);
+  }
+
+  inline BLRectI next_rect_i(const BLSizeI& bounds, int w, int h) {
+    if (!_workload.enabled)
+      return _rnd_coord.next_rect_i(bounds, w, h);
+
+    const double* p = _workload.origins.data() + _workload.origin_index;
+    _workload.origin_index += 2;
+    return BLRectI(int(p[0]), int(p[1]), w, h);
+  }
+
+  inline BLPoint next_origin(const BLSizeI& bounds) {
+    if (!_workload.enabled)
+      return _rnd_coord.nextPoint(bounds);
+
+    const double* p = _workload.origins.data() + _workload.origin_index;
+    _workload.origin_index += 2;
+    return BLPoint(p[0], p[1]);
+  }
+
+  inline double next_vertex_coord(double a, double b) {
+    if (!_workload.enabled)
+      return _rnd_coord.next_double(a, b);
+
+    return _workload.vertices[_workload.vertex_index++];
+  }
+
+  //! Returns a vertex of a polygon at `index` - random vertices are generated, star vertices are translated by `base`.
+  inline BLPoint next_vertex(PolygonKind kind, const BLPoint& base, double wh, uint32_t index) {
+    if (kind == PolygonKind::kStar)
+      return BLPoint(base.x + _star_vertices[index].x, base.y + _star_vertices[index].y);
+
+    double x = next_vertex_coord(base.x, base.x + wh);
+    double y = next_vertex_coord(base.y, base.y + wh);
+    return BLPoint(x, y);
+  }
+
+  //! Returns true if `before_run()` should build the path of a shape test that is replayed at each origin, see
+  //! `ShapePathMode::kReplay`.
+  inline bool needs_replay_path() const {
+    return _params.shape_path == ShapePathMode::kReplay && is_shape_test(_params.testKind);
+  }
+
+  //! Returns the index of the next cached path and its origin, see `ShapePathMode::kCached`.
+  inline uint32_t next_cached_shape() {
+    uint32_t i = _cached_shape_index;
+    if (++_cached_shape_index >= _cached_shape_origins.size())
+      _cached_shape_index = 0;
+    return i;
+  }
+
+  inline BLRgba32 next_color(uint32_t mask = 0u) {
+    if (!_workload.enabled)
+      return _rnd_color.next_rgba32(mask);
+
+    return BLRgba32(_workload.colors[_workload.color_index++] | mask);
+  }
+
+  //! Returns the destination of a blit test - the origin is generated the same way as an origin of a rectangle of
+  //! the shape size, which is either integral or fractional.
+  inline BLRect next_blit_rect(const BLSizeI& dst_size, bool fractional) {
+    int wh = int(_params.shape_size);
+
+    if (fractional) {
+      BLRect r = next_rect(BLSize(_params.screen_w, _params.screen_h), wh, wh);
+      return BLRect(r.x, r.y, dst_size.w, dst_size.h);
+    }
+    else {
+      BLRectI r = next_rect_i(BLSizeI(_params.screen_w, _params.screen_h), wh, wh);
+      return BLRect(r.x, r.y, dst_size.w, dst_size.h);
+    }
+  }
+
+  //! Returns the clip rectangle of `ClipMode::kStatic` - the screen inset by 1/8 of its size on each side.
+  inline BLRectI static_clip_rect() const {
+    int w = int(_params.screen_w);
+    int h = int(_params.screen_h);
+    return BLRectI(w / 8, h / 8, w - (w / 8) * 2, h - (h / 8) * 2);
+  }
+
+  inline double next_radius() {
+    if (!_workload.enabled)
+      return _rnd_extra.next_double(4.0, 40.0);
+
+    return _workload.radii[_workload.radius_index++];
+  }
+
   virtual void serialize_info(JSONBuilder& json) const;
 
   virtual bool supports_comp_op(BLCompOp comp_op) const = 0;
   virtual bool supports_style(StyleKind style) const = 0;
+  virtual bool supports_format(BLFormat format) const = 0;
+  virtual bool supports_test(TestKind test) const = 0;
+  virtual bool supports_stroke(StrokeKind stroke) const = 0;
+  virtual bool supports_shape_path(ShapePathMode shape_path) const = 0;
 
   virtual void before_run() = 0;
   virtual void flush() = 0;
@@ -239,11 +733,31 @@ struct Backend {
 
   virtual void render_rect_a(RenderOp op) = 0;
   virtual void render_rect_f(RenderOp op) = 0;
+  //! Renders `quantity` rectangles in batches of `kBenchBatchSize` - each batch is a single render call (or a single
+  //! path) with a single style spanning the whole screen. Rectangles of a batch are generated before its style.
+  virtual void render_rect_a_batch(RenderOp op) = 0;
+  virtual void render_rect_f_batch(RenderOp op) = 0;
   virtual void render_rect_rotated(RenderOp op) = 0;
   virtual void render_round_f(RenderOp op) = 0;
   virtual void render_round_rotated(RenderOp op) = 0;
-  virtual void render_polygon(RenderOp op, uint32_t complexity) = 0;
+  //! Renders `quantity` polygons of `complexity` vertices, see `next_vertex()`. Vertices are stored on the stack up to
+  //! `kBenchMaxStackVertices` and in a buffer sized by `before_run()` otherwise (or added to a path one by one), thus
+  //! the complexity is not limited and render calls don't allocate.
+  virtual void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) = 0;
+  //! Renders `quantity` shapes - the path of the shape is built depending on `ShapePathMode`.
   virtual void render_shape(RenderOp op, ShapeData shape) = 0;
+  //! Renders `quantity` texts at random origins by using the font returned by `get_text_font_data()` and the shape
+  //! size as a font size. `TextKind::kGlyphRun` is shaped once by `before_run()` and then rendered as a glyph run.
+  virtual void render_text(TextKind kind) = 0;
+  //! Blits `quantity` sprites scaled to `dst_size` at random origins, which are either integral or fractional.
+  virtual void render_blit_scaled(BLSizeI dst_size, bool fractional) = 0;
+  //! Fills `quantity` smooth rectangles with the current style under an active clip, see `ClipMode`.
+  virtual void render_rect_clip(ClipMode mode) = 0;
+  //! Fills `quantity` smooth rectangles with a gradient of the current style having `stop_count` stops of
+  //! `_gradient_colors`. If `reuse` is false the gradient is rebuilt by each render call and its first stop gets a
+  //! new color, thus its lookup table cannot be cached. Otherwise a single gradient is built at the origin before
+  //! the loop and each render call only translates it, thus its lookup table is built once.
+  virtual void render_gradient_stops(uint32_t stop_count, bool reuse) = 0;
 };
 
 } // {blbench}
@@ -49,6 +49,26 @@ static inline Agg2D::Color to_agg2d_color(BLRgba32 rgba32) {
   return Agg2D::Color(rgba32.r(), rgba32.g(), rgba32.b(), rgba32.a());
 }
 
+static inline Agg2D::LineJoin to_agg2d_line_join(StrokeJoin join) {
+  switch (join) {
+    case StrokeJoin::kRound: return Agg2D::JoinRound;
+    case StrokeJoin::kBevel: return Agg2D::JoinBevel;
+
+    default:
+      return Agg2D::JoinMiter;
+  }
+}
+
+static inline Agg2D::LineCap to_agg2d_line_cap(StrokeCap cap) {
+  switch (cap) {
+    case StrokeCap::kRound : return Agg2D::CapRound;
+    case StrokeCap::kSquare: return Agg2D::CapSquare;
+
+    default:
+      return Agg2D::CapButt;
+  }
+}
+
 struct AggModule : public Backend {
   Agg2D _ctx;
 
@@ -57,6 +77,10 @@ struct AggModule : public Backend {
 
   bool supports_comp_op(BLCompOp comp_op) const override;
   bool supports_style(StyleKind style) const override;
+  bool supports_format(BLFormat format) const override;
+  bool supports_test(TestKind test) const override;
+  bool supports_stroke(StrokeKind stroke) const override;
+  bool supports_shape_path(ShapePathMode shape_path) const override;
 
   void before_run() override;
   void flush() override;
@@ -69,11 +93,17 @@ struct AggModule : public Backend {
 
   void render_rect_a(RenderOp op) override;
   void render_rect_f(RenderOp op) override;
+  void render_rect_a_batch(RenderOp op) override;
+  void render_rect_f_batch(RenderOp op) override;
   void render_rect_rotated(RenderOp op) override;
   void render_round_f(RenderOp op) override;
   void render_round_rotated(RenderOp op) override;
-  void render_polygon(RenderOp op, uint32_t complexity) override;
+  void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) override;
   void render_shape(RenderOp op, ShapeData shape) override;
+  void render_text(TextKind kind) override;
+  void render_blit_scaled(BLSizeI dst_size, bool fractional) override;
+  void render_rect_clip(ClipMode mode) override;
+  void render_gradient_stops(uint32_t stop_count, bool reuse) override;
 };
 
 AggModule::AggModule() {
@@ -95,6 +125,28 @@ bool AggModule::supports_style(StyleKind style) const {
          style == StyleKind::kRadialReflect ;
 }
 
+bool AggModule::supports_format(BLFormat format) const {
+  // Agg2D is hardwired to RGBA32 pixel format.
+  return format == BL_FORMAT_PRGB32;
+}
+
+bool AggModule::supports_test(TestKind test) const {
+  // Agg2D doesn't provide text rendering from in-memory font data and this backend doesn't implement images. Agg2D
+  // gradients are limited to three colors.
+  return !is_text_test(test) && !is_blit_test(test) && !is_gradient_stop_test(test);
+}
+
+bool AggModule::supports_stroke(StrokeKind stroke) const {
+  // Agg2D doesn't provide dashes (its miter limit is fixed to 4, which is the same as `kBenchMiterLimit`).
+  return !stroke_options_of(stroke).is_dashed();
+}
+
+bool AggModule::supports_shape_path(ShapePathMode shape_path) const {
+  // Agg2D has no path object that could be cached, thus shapes are always rebuilt by each render call (replay mode
+  // measures the same as rebuild mode).
+  return shape_path != ShapePathMode::kCached;
+}
+
 void AggModule::before_run() {
   int w = int(_params.screen_w);
   int h = int(_params.screen_h);
@@ -111,6 +163,11 @@ void AggModule::before_run() {
 
   _ctx.fillEvenOdd(false);
   _ctx.noLine();
+
+  const StrokeOptions& stroke = stroke_options_of(_params.stroke);
+  _ctx.lineWidth(stroke.width);
+  _ctx.lineJoin(to_agg2d_line_join(stroke.join));
+  _ctx.lineCap(to_agg2d_line_cap(stroke.cap));
   _ctx.blendMode(Agg2D::BlendSrc);
   _ctx.clearAll(Agg2D::Color(0, 0, 0, 0));
   _ctx.blendMode(Agg2D::BlendMode(to_agg2d_blend_mode(_params.comp_op)));
@@ -135,7 +192,7 @@ template<typename RectT>
 void AggModule::setup_style(RenderOp op, const RectT& rect) {
   switch (_params.style) {
     case StyleKind::kSolid: {
-      BLRgba32 color = _rnd_color.next_rgba32();
+      BLRgba32 color = next_color();
       if (op == RenderOp::kStroke)
         _ctx.lineColor(to_agg2d_color(color));
       else
@@ -151,9 +208,9 @@ void AggModule::setup_style(RenderOp op, const RectT& rect) {
       double x2 = rect.x + rect.w * 0.8;
       double y2 = rect.y + rect.h * 0.8;
 
-      BLRgba32 c1 = _rnd_color.next_rgba32();
-      BLRgba32 c2 = _rnd_color.next_rgba32();
-      BLRgba32 c3 = _rnd_color.next_rgba32();
+      BLRgba32 c1 = next_color();
+      BLRgba32 c2 = next_color();
+      BLRgba32 c3 = next_color();
 
       if (op == RenderOp::kStroke)
         _ctx.lineLinearGradient(x1, y1, x2, y2, to_agg2d_color(c1), to_agg2d_color(c2), to_agg2d_color(c3));
@@ -169,9 +226,9 @@ void AggModule::setup_style(RenderOp op, const RectT& rect) {
       double cy = rect.y + rect.h / 2.0;
       double cr = (rect.w + rect.h) / 4.0;
 
-      BLRgba32 c1 = _rnd_color.next_rgba32();
-      BLRgba32 c2 = _rnd_color.next_rgba32();
-      BLRgba32 c3 = _rnd_color.next_rgba32();
+      BLRgba32 c1 = next_color();
+      BLRgba32 c2 = next_color();
+      BLRgba32 c3 = next_color();
 
       if (op == RenderOp::kStroke)
         _ctx.lineRadialGradient(cx, cy, cr, to_agg2d_color(c1), to_agg2d_color(c2), to_agg2d_color(c3));
@@ -194,13 +251,13 @@ void AggModule::render_rect_a(RenderOp op) {
 
   if (_params.style == StyleKind::kSolid && op != RenderOp::kStroke) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI rect = _rnd_coord.next_rect_i(bounds, wh, wh);
-      _ctx.fillRectangleI(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h, to_agg2d_color(_rnd_color.next_rgba32()));
+      BLRectI rect = next_rect_i(bounds, wh, wh);
+      _ctx.fillRectangleI(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h, to_agg2d_color(next_color()));
     }
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI rect = _rnd_coord.next_rect_i(bounds, wh, wh);
+      BLRectI rect = next_rect_i(bounds, wh, wh);
       setup_style(op, rect);
       _ctx.rectangle(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h);
     }
@@ -215,12 +272,67 @@ void AggModule::render_rect_f(RenderOp op) {
   prepare_fill_stroke_option(op);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRect rect = _rnd_coord.next_rect(bounds, wh, wh);
+    BLRect rect = next_rect(bounds, wh, wh);
     setup_style(op, rect);
     _ctx.rectangle(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h);
   }
 }
 
+void AggModule::render_rect_a_batch(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  int wh = _params.shape_size;
+
+  prepare_fill_stroke_option(op);
+  _ctx.fillEvenOdd(false);
+
+  Agg2D::DrawPathFlag draw_path_flag = op == RenderOp::kStroke ? Agg2D::StrokeOnly : Agg2D::FillOnly;
+
+  // All rectangles of a batch are added to a single path, which is then rendered by a single rasterizer pass.
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    _ctx.resetPath();
+    for (uint32_t j = 0; j < n; j++) {
+      BLRectI rect = next_rect_i(bounds, wh, wh);
+      _ctx.moveTo(rect.x, rect.y);
+      _ctx.lineTo(rect.x + rect.w, rect.y);
+      _ctx.lineTo(rect.x + rect.w, rect.y + rect.h);
+      _ctx.lineTo(rect.x, rect.y + rect.h);
+      _ctx.closePolygon();
+    }
+
+    setup_style(op, BLRectI(0, 0, bounds.w, bounds.h));
+    _ctx.drawPath(draw_path_flag);
+  }
+}
+
+void AggModule::render_rect_f_batch(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  double wh = _params.shape_size;
+
+  prepare_fill_stroke_option(op);
+  _ctx.fillEvenOdd(false);
+
+  Agg2D::DrawPathFlag draw_path_flag = op == RenderOp::kStroke ? Agg2D::StrokeOnly : Agg2D::FillOnly;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    _ctx.resetPath();
+    for (uint32_t j = 0; j < n; j++) {
+      BLRect rect = next_rect(bounds, wh, wh);
+      _ctx.moveTo(rect.x, rect.y);
+      _ctx.lineTo(rect.x + rect.w, rect.y);
+      _ctx.lineTo(rect.x + rect.w, rect.y + rect.h);
+      _ctx.lineTo(rect.x, rect.y + rect.h);
+      _ctx.closePolygon();
+    }
+
+    setup_style(op, BLRect(0, 0, bounds.w, bounds.h));
+    _ctx.drawPath(draw_path_flag);
+  }
+}
+
 void AggModule::render_rect_rotated(RenderOp op) {
   BLSize bounds(_params.screen_w, _params.screen_h);
   StyleKind style = _params.style;
@@ -228,12 +340,12 @@ void AggModule::render_rect_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   prepare_fill_stroke_option(op);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+    BLRect rect(next_rect(bounds, wh, wh));
 
     agg::trans_affine affine;
     affine.translate(-cx, -cy);
@@ -245,6 +357,8 @@ void AggModule::render_rect_rotated(RenderOp op) {
     _ctx.rectangle(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h);
     _ctx.resetTransformations();
   }
+
+  _rotation_angle = angle;
 }
 
 void AggModule::render_round_f(RenderOp op) {
@@ -255,8 +369,8 @@ void AggModule::render_round_f(RenderOp op) {
   prepare_fill_stroke_option(op);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRect rect = _rnd_coord.next_rect(bounds, wh, wh);
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect = next_rect(bounds, wh, wh);
+    double radius = next_radius();
 
     setup_style(op, rect);
     _ctx.roundedRect(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h, radius);
@@ -270,13 +384,13 @@ void AggModule::render_round_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   prepare_fill_stroke_option(op);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect(next_rect(bounds, wh, wh));
+    double radius = next_radius();
 
     agg::trans_affine affine;
     affine.translate(-cx, -cy);
@@ -288,9 +402,11 @@ void AggModule::render_round_rotated(RenderOp op) {
     _ctx.roundedRect(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h, radius);
     _ctx.resetTransformations();
   }
+
+  _rotation_angle = angle;
 }
 
-void AggModule::render_polygon(RenderOp op, uint32_t complexity) {
+void AggModule::render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
 
@@ -303,18 +419,16 @@ void AggModule::render_polygon(RenderOp op, uint32_t complexity) {
   Agg2D::DrawPathFlag draw_path_flag = op == RenderOp::kStroke ? Agg2D::StrokeOnly : Agg2D::FillOnly;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base(next_origin(bounds));
 
-    double x = _rnd_coord.next_double(base.x, base.x + wh);
-    double y = _rnd_coord.next_double(base.y, base.y + wh);
+    BLPoint v = next_vertex(kind, base, wh, 0);
 
     _ctx.resetPath();
-    _ctx.moveTo(x, y);
+    _ctx.moveTo(v.x, v.y);
 
     for (uint32_t p = 1; p < complexity; p++) {
-      x = _rnd_coord.next_double(base.x, base.x + wh);
-      y = _rnd_coord.next_double(base.y, base.y + wh);
-      _ctx.lineTo(x, y);
+      v = next_vertex(kind, base, wh, p);
+      _ctx.lineTo(v.x, v.y);
     }
 
     setup_style(op, BLRect(base.x, base.y, wh, wh));
@@ -335,7 +449,7 @@ void AggModule::render_shape(RenderOp op, ShapeData shape) {
   Agg2D::DrawPathFlag draw_path_flag = op == RenderOp::kStroke ? Agg2D::StrokeOnly : Agg2D::FillOnly;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base(next_origin(bounds));
     ShapeIterator it(shape);
 
     _ctx.resetPath();
@@ -370,6 +484,68 @@ void AggModule::render_shape(RenderOp op, ShapeData shape) {
   }
 }
 
+void AggModule::render_text(TextKind kind) {
+  // Not supported, see supports_test().
+  (void)kind;
+}
+
+void AggModule::render_blit_scaled(BLSizeI dst_size, bool fractional) {
+  // Not supported, see supports_test().
+  (void)dst_size;
+  (void)fractional;
+}
+
+void AggModule::render_rect_clip(ClipMode mode) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  double wh = _params.shape_size;
+
+  prepare_fill_stroke_option(RenderOp::kFillNonZero);
+
+  // Agg2D has no clip stack - `clipBox()` replaces the clip box, thus nested scopes are emulated by intersecting
+  // the outer and inner clip box and restoring the outer one before leaving the inner scope.
+  if (mode == ClipMode::kStatic) {
+    BLRectI clip = static_clip_rect();
+    _ctx.clipBox(clip.x, clip.y, clip.x + clip.w, clip.y + clip.h);
+  }
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect = next_rect(bounds, wh, wh);
+
+    if (mode == ClipMode::kNested) {
+      BLRect outer = clip_outer_rect(rect);
+      BLRect inner = clip_inner_rect(rect);
+
+      _ctx.clipBox(outer.x, outer.y, outer.x + outer.w, outer.y + outer.h);
+      _ctx.clipBox(std::max(outer.x, inner.x), std::max(outer.y, inner.y),
+                   std::min(outer.x + outer.w, inner.x + inner.w), std::min(outer.y + outer.h, inner.y + inner.h));
+    }
+    else if (mode == ClipMode::kPerCall) {
+      BLRect clip = clip_call_rect(rect);
+      _ctx.clipBox(clip.x, clip.y, clip.x + clip.w, clip.y + clip.h);
+    }
+
+    setup_style(RenderOp::kFillNonZero, rect);
+    _ctx.rectangle(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h);
+
+    if (mode == ClipMode::kNested) {
+      BLRect outer = clip_outer_rect(rect);
+      _ctx.clipBox(outer.x, outer.y, outer.x + outer.w, outer.y + outer.h);
+    }
+
+    if (mode != ClipMode::kStatic)
+      _ctx.clipBox(0, 0, bounds.w, bounds.h);
+  }
+
+  if (mode == ClipMode::kStatic)
+    _ctx.clipBox(0, 0, bounds.w, bounds.h);
+}
+
+void AggModule::render_gradient_stops(uint32_t stop_count, bool reuse) {
+  // Not supported, see supports_test().
+  (void)stop_count;
+  (void)reuse;
+}
+
 Backend* create_agg_backend() {
   return new AggModule();
 }
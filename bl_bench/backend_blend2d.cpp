@@ -11,6 +11,98 @@
 
 namespace blbench {
 
+// Other libraries bevel miter joins that exceed the miter limit, which is BL_STROKE_JOIN_MITER_BEVEL in Blend2D.
+static inline BLStrokeJoin to_bl_stroke_join(StrokeJoin join) {
+  switch (join) {
+    case StrokeJoin::kRound: return BL_STROKE_JOIN_ROUND;
+    case StrokeJoin::kBevel: return BL_STROKE_JOIN_BEVEL;
+
+    default:
+      return BL_STROKE_JOIN_MITER_BEVEL;
+  }
+}
+
+static inline BLStrokeCap to_bl_stroke_cap(StrokeCap cap) {
+  switch (cap) {
+    case StrokeCap::kRound : return BL_STROKE_CAP_ROUND;
+    case StrokeCap::kSquare: return BL_STROKE_CAP_SQUARE;
+
+    default:
+      return BL_STROKE_CAP_BUTT;
+  }
+}
+
+// Sets the geometry of a gradient of `style` spanning `rect`, which is the same as used by `setup_style()`.
+static void set_gradient_values(BLGradient& gradient, const BLRect& rect, StyleKind style) {
+  switch (style) {
+    case StyleKind::kLinearPad:
+    case StyleKind::kLinearRepeat:
+    case StyleKind::kLinearReflect: {
+      BLLinearGradientValues values {};
+      values.x0 = rect.x + rect.w * 0.2;
+      values.y0 = rect.y + rect.h * 0.2;
+      values.x1 = rect.x + rect.w * 0.8;
+      values.y1 = rect.y + rect.h * 0.8;
+      gradient.set_values(values);
+      break;
+    }
+
+    case StyleKind::kRadialPad:
+    case StyleKind::kRadialRepeat:
+    case StyleKind::kRadialReflect: {
+      BLRadialGradientValues values {};
+      values.x0 = rect.x + (rect.w / 2);
+      values.y0 = rect.y + (rect.h / 2);
+      values.r0 = (rect.w + rect.h) / 4;
+      values.x1 = values.x0 - values.r0 / 2.0;
+      values.y1 = values.y0 - values.r0 / 2.0;
+      gradient.set_values(values);
+      break;
+    }
+
+    default: {
+      BLConicGradientValues values {};
+      values.x0 = rect.x + (rect.w / 2);
+      values.y0 = rect.y + (rect.h / 2);
+      values.angle = 0;
+      values.repeat = 1;
+      gradient.set_values(values);
+      break;
+    }
+  }
+}
+
+// Adds `shape` scaled by `scale` and translated by `offset` to `path`.
+static void add_shape_path(BLPath& path, ShapeData shape, double scale, const BLPoint& offset) {
+  double x = offset.x;
+  double y = offset.y;
+
+  ShapeIterator it(shape);
+  while (it.has_command()) {
+    if (it.is_move_to()) {
+      path.move_to(x + it.x(0) * scale, y + it.y(0) * scale);
+    }
+    else if (it.is_line_to()) {
+      path.line_to(x + it.x(0) * scale, y + it.y(0) * scale);
+    }
+    else if (it.is_quad_to()) {
+      path.quad_to(
+        x + it.x(0) * scale, y + it.y(0) * scale,
+        x + it.x(1) * scale, y + it.y(1) * scale);
+    }
+    else if (it.is_cubic_to()) {
+      path.cubic_to(
+        x + it.x(0) * scale, y + it.y(0) * scale,
+        x + it.x(1) * scale, y + it.y(1) * scale,
+        x + it.x(2) * scale, y + it.y(2) * scale);
+    }
+    else {
+      path.close();
+    }
+    it.next();
+  }
+}
+
 class Blend2DModule : public Backend {
 public:
 
@@ -22,6 +114,19 @@ public:
   BLGradientType _gradient_type;
   BLExtendMode _gradient_extend;
 
+  // Initialized by before_run() of high vertex-count polygon tests.
+  std::vector<BLPoint> _polygon_points;
+
+  // Initialized by before_run() of shape tests - the path to replay (or to rebuild, which keeps its capacity across
+  // render calls) and paths of ShapePathMode::kCached.
+  BLPath _shape_path;
+  std::vector<BLPath> _cached_paths;
+
+  // Initialized by before_run() of text tests.
+  BLFontFace _font_face;
+  BLFont _font;
+  BLGlyphBuffer _glyph_buffer;
+
   // Construction & Destruction
   // --------------------------
 
@@ -35,6 +140,10 @@ public:
 
   bool supports_comp_op(BLCompOp comp_op) const override;
   bool supports_style(StyleKind style) const override;
+  bool supports_format(BLFormat format) const override;
+  bool supports_test(TestKind test) const override;
+  bool supports_stroke(StrokeKind stroke) const override;
+  bool supports_shape_path(ShapePathMode shape_path) const override;
 
   void before_run() override;
   void flush() override;
@@ -45,11 +154,20 @@ public:
 
   void render_rect_a(RenderOp op) override;
   void render_rect_f(RenderOp op) override;
+  void render_rect_a_batch(RenderOp op) override;
+  void render_rect_f_batch(RenderOp op) override;
   void render_rect_rotated(RenderOp op) override;
   void render_round_f(RenderOp op) override;
   void render_round_rotated(RenderOp op) override;
-  void render_polygon(RenderOp op, uint32_t complexity) override;
+  void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) override;
   void render_shape(RenderOp op, ShapeData shape) override;
+  void render_text(TextKind kind) override;
+  void render_blit_scaled(BLSizeI dst_size, bool fractional) override;
+  void render_rect_clip(ClipMode mode) override;
+  void render_gradient_stops(uint32_t stop_count, bool reuse) override;
+
+  template<typename StyleT>
+  inline void render_text_lines(const BLPoint& pos, TextKind kind, const TextData& text, const StyleT& style);
 };
 
 Blend2DModule::Blend2DModule(uint32_t thread_count, uint32_t cpu_features) {
@@ -92,9 +210,9 @@ void Blend2DModule::serialize_info(JSONBuilder& json) const {
 template<typename RectT>
 inline const BLVar& Blend2DModule::setup_style(const RectT& rect, StyleKind style, BLGradient& gradient, BLPattern& pattern) {
   if (style <= StyleKind::kConic) {
-    BLRgba32 c0(_rnd_color.next_rgba32());
-    BLRgba32 c1(_rnd_color.next_rgba32());
-    BLRgba32 c2(_rnd_color.next_rgba32());
+    BLRgba32 c0(next_color());
+    BLRgba32 c1(next_color());
+    BLRgba32 c2(next_color());
 
     switch (style) {
       case StyleKind::kLinearPad:
@@ -165,6 +283,25 @@ bool Blend2DModule::supports_style(StyleKind style) const {
   return true;
 }
 
+bool Blend2DModule::supports_format(BLFormat format) const {
+  return format == BL_FORMAT_PRGB32 ||
+         format == BL_FORMAT_XRGB32 ||
+         format == BL_FORMAT_A8     ;
+}
+
+bool Blend2DModule::supports_test(TestKind test) const {
+  return true;
+}
+
+bool Blend2DModule::supports_stroke(StrokeKind stroke) const {
+  // Blend2D's stroker doesn't implement dashes.
+  return !stroke_options_of(stroke).is_dashed();
+}
+
+bool Blend2DModule::supports_shape_path(ShapePathMode shape_path) const {
+  return true;
+}
+
 void Blend2DModule::before_run() {
   int w = int(_params.screen_w);
   int h = int(_params.screen_h);
@@ -189,7 +326,12 @@ void Blend2DModule::before_run() {
   _context.fill_all(BLRgba32(0x00000000));
 
   _context.set_comp_op(_params.comp_op);
-  _context.set_stroke_width(_params.stroke_width);
+
+  const StrokeOptions& stroke = stroke_options_of(_params.stroke);
+  _context.set_stroke_width(stroke.width);
+  _context.set_stroke_join(to_bl_stroke_join(stroke.join));
+  _context.set_stroke_caps(to_bl_stroke_cap(stroke.cap));
+  _context.set_stroke_miter_limit(kBenchMiterLimit);
 
   _context.set_pattern_quality(
     _params.style == StyleKind::kPatternNN
@@ -213,6 +355,39 @@ void Blend2DModule::before_run() {
       break;
   }
 
+  _polygon_points.resize(vertices_per_call(_params.testKind));
+
+  _shape_path.clear();
+  if (needs_replay_path())
+    add_shape_path(_shape_path, _cached_shape, double(_params.shape_size), BLPoint(0, 0));
+
+  _cached_paths.resize(_cached_shape_origins.size());
+  for (size_t i = 0; i < _cached_paths.size(); i++) {
+    _cached_paths[i].clear();
+    add_shape_path(_cached_paths[i], _cached_shape, double(_params.shape_size), _cached_shape_origins[i]);
+  }
+
+  if (is_text_test(_params.testKind)) {
+    if (!_font_face.is_valid()) {
+      size_t font_data_size;
+      const uint8_t* font_data = get_text_font_data(&font_data_size);
+
+      BLFontData fd;
+      fd.create_from_data(font_data, font_data_size);
+      _font_face.create_from_data(fd, 0);
+    }
+
+    _font.create_from_face(_font_face, float(_params.shape_size));
+
+    if (_params.testKind == TestKind::kFillGlyphRun) {
+      TextData text;
+      get_text_data(text, TextKind::kGlyphRun);
+
+      _glyph_buffer.set_utf8_text(text.lines[0]);
+      _font.shape(_glyph_buffer);
+    }
+  }
+
   _context.flush(BL_CONTEXT_FLUSH_SYNC);
 }
 
@@ -231,8 +406,8 @@ void Blend2DModule::render_rect_a(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
-      BLRgba32 color(_rnd_color.next_rgba32());
+      BLRectI rect(next_rect_i(bounds, wh, wh));
+      BLRgba32 color(next_color());
 
       if (op == RenderOp::kStroke)
         _context.stroke_rect(BLRect(rect.x, rect.y, rect.w, rect.h), color);
@@ -242,7 +417,7 @@ void Blend2DModule::render_rect_a(RenderOp op) {
   }
   else if ((style == StyleKind::kPatternNN || style == StyleKind::kPatternBI) && op != RenderOp::kStroke) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
+      BLRectI rect(next_rect_i(bounds, wh, wh));
       _context.blit_image(BLPointI(rect.x, rect.y), _sprites[nextSpriteId()]);
     }
   }
@@ -252,7 +427,7 @@ void Blend2DModule::render_rect_a(RenderOp op) {
     gradient.set_extend_mode(_gradient_extend);
 
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
+      BLRectI rect(next_rect_i(bounds, wh, wh));
       const auto& obj = setup_style(rect, style, gradient, pattern);
 
       if (op == RenderOp::kStroke)
@@ -270,8 +445,8 @@ void Blend2DModule::render_rect_f(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-      BLRgba32 color(_rnd_color.next_rgba32());
+      BLRect rect(next_rect(bounds, wh, wh));
+      BLRgba32 color(next_color());
 
       if (op == RenderOp::kStroke)
         _context.stroke_rect(rect, color);
@@ -281,7 +456,7 @@ void Blend2DModule::render_rect_f(RenderOp op) {
   }
   else if ((style == StyleKind::kPatternNN || style == StyleKind::kPatternBI) && op != RenderOp::kStroke) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      BLRect rect(next_rect(bounds, wh, wh));
       _context.blit_image(BLPoint(rect.x, rect.y), _sprites[nextSpriteId()]);
     }
   }
@@ -291,7 +466,7 @@ void Blend2DModule::render_rect_f(RenderOp op) {
     gradient.set_extend_mode(_gradient_extend);
 
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      BLRect rect(next_rect(bounds, wh, wh));
       const auto& obj = setup_style(rect, style, gradient, pattern);
 
       if (op == RenderOp::kStroke)
@@ -302,6 +477,78 @@ void Blend2DModule::render_rect_f(RenderOp op) {
   }
 }
 
+void Blend2DModule::render_rect_a_batch(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  int wh = _params.shape_size;
+
+  BLRectI rects[kBenchBatchSize];
+  BLRectI style_rect(0, 0, bounds.w, bounds.h);
+
+  BLPattern pattern;
+  BLGradient gradient(_gradient_type);
+  gradient.set_extend_mode(_gradient_extend);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+    for (uint32_t j = 0; j < n; j++)
+      rects[j] = next_rect_i(bounds, wh, wh);
+
+    if (style == StyleKind::kSolid) {
+      BLRgba32 color(next_color());
+
+      if (op == RenderOp::kStroke)
+        _context.stroke_rect_array(rects, n, color);
+      else
+        _context.fill_rect_array(rects, n, color);
+    }
+    else {
+      const auto& obj = setup_style(style_rect, style, gradient, pattern);
+
+      if (op == RenderOp::kStroke)
+        _context.stroke_rect_array(rects, n, obj);
+      else
+        _context.fill_rect_array(rects, n, obj);
+    }
+  }
+}
+
+void Blend2DModule::render_rect_f_batch(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  BLRect rects[kBenchBatchSize];
+  BLRect style_rect(0, 0, bounds.w, bounds.h);
+
+  BLPattern pattern;
+  BLGradient gradient(_gradient_type);
+  gradient.set_extend_mode(_gradient_extend);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+    for (uint32_t j = 0; j < n; j++)
+      rects[j] = next_rect(bounds, wh, wh);
+
+    if (style == StyleKind::kSolid) {
+      BLRgba32 color(next_color());
+
+      if (op == RenderOp::kStroke)
+        _context.stroke_rect_array(rects, n, color);
+      else
+        _context.fill_rect_array(rects, n, color);
+    }
+    else {
+      const auto& obj = setup_style(style_rect, style, gradient, pattern);
+
+      if (op == RenderOp::kStroke)
+        _context.stroke_rect_array(rects, n, obj);
+      else
+        _context.fill_rect_array(rects, n, obj);
+    }
+  }
+}
+
 void Blend2DModule::render_rect_rotated(RenderOp op) {
   BLSize bounds(_params.screen_w, _params.screen_h);
   StyleKind style = _params.style;
@@ -309,12 +556,12 @@ void Blend2DModule::render_rect_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-      BLRgba32 color(_rnd_color.next_rgba32());
+      BLRect rect(next_rect(bounds, wh, wh));
+      BLRgba32 color(next_color());
 
       _context.rotate(angle, BLPoint(cx, cy));
 
@@ -328,7 +575,7 @@ void Blend2DModule::render_rect_rotated(RenderOp op) {
   }
   else if ((style == StyleKind::kPatternNN || style == StyleKind::kPatternBI) && op != RenderOp::kStroke) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      BLRect rect(next_rect(bounds, wh, wh));
 
       _context.save();
       _context.rotate(angle, BLPoint(cx, cy));
@@ -342,7 +589,7 @@ void Blend2DModule::render_rect_rotated(RenderOp op) {
     gradient.set_extend_mode(_gradient_extend);
 
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      BLRect rect(next_rect(bounds, wh, wh));
       const auto& obj = setup_style(rect, style, gradient, pattern);
 
       _context.save();
@@ -356,6 +603,8 @@ void Blend2DModule::render_rect_rotated(RenderOp op) {
       _context.restore();
     }
   }
+
+  _rotation_angle = angle;
 }
 
 void Blend2DModule::render_round_f(RenderOp op) {
@@ -365,11 +614,11 @@ void Blend2DModule::render_round_f(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      double radius = _rnd_extra.next_double(4.0, 40.0);
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      double radius = next_radius();
+      BLRect rect(next_rect(bounds, wh, wh));
       BLRoundRect round(rect, radius);
 
-      BLRgba32 color(_rnd_color.next_rgba32());
+      BLRgba32 color(next_color());
       if (op == RenderOp::kStroke)
         _context.stroke_round_rect(round, color);
       else
@@ -382,8 +631,8 @@ void Blend2DModule::render_round_f(RenderOp op) {
     gradient.set_extend_mode(_gradient_extend);
 
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      double radius = _rnd_extra.next_double(4.0, 40.0);
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      double radius = next_radius();
+      BLRect rect(next_rect(bounds, wh, wh));
       BLRoundRect round(rect, radius);
 
       const auto& obj = setup_style(rect, style, gradient, pattern);
@@ -402,16 +651,16 @@ void Blend2DModule::render_round_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-      double radius = _rnd_extra.next_double(4.0, 40.0);
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      double radius = next_radius();
+      BLRect rect(next_rect(bounds, wh, wh));
       BLRoundRect round(rect, radius);
 
       _context.rotate(angle, BLPoint(cx, cy));
-      BLRgba32 color(_rnd_color.next_rgba32());
+      BLRgba32 color(next_color());
 
       if (op == RenderOp::kStroke)
         _context.stroke_round_rect(round, color);
@@ -427,8 +676,8 @@ void Blend2DModule::render_round_rotated(RenderOp op) {
     gradient.set_extend_mode(_gradient_extend);
 
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-      double radius = _rnd_extra.next_double(4.0, 40.0);
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      double radius = next_radius();
+      BLRect rect(next_rect(bounds, wh, wh));
       BLRoundRect round(rect, radius);
 
       const auto& obj = setup_style(rect, style, gradient, pattern);
@@ -444,19 +693,18 @@ void Blend2DModule::render_round_rotated(RenderOp op) {
       _context.restore();
     }
   }
-}
 
-void Blend2DModule::render_polygon(RenderOp op, uint32_t complexity) {
-  static constexpr uint32_t kPointCapacity = 128;
-
-  if (complexity > kPointCapacity)
-    return;
+  _rotation_angle = angle;
+}
 
+void Blend2DModule::render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) {
   BLSizeI bounds(_params.screen_w - _params.shape_size, _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
   double wh = double(_params.shape_size);
 
-  BLPoint points[kPointCapacity];
+  BLPoint stack_points[kBenchMaxStackVertices];
+  BLPoint* points = complexity <= kBenchMaxStackVertices ? stack_points : _polygon_points.data();
+
   BLPattern pattern;
   BLGradient gradient(_gradient_type);
 
@@ -464,16 +712,14 @@ void Blend2DModule::render_polygon(RenderOp op, uint32_t complexity) {
   gradient.set_extend_mode(_gradient_extend);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base(next_origin(bounds));
 
     for (uint32_t p = 0; p < complexity; p++) {
-      double x = _rnd_coord.next_double(base.x, base.x + wh);
-      double y = _rnd_coord.next_double(base.y, base.y + wh);
-      points[p].reset(x, y);
+      points[p] = next_vertex(kind, base, wh, p);
     }
 
     if (style == StyleKind::kSolid) {
-      BLRgba32 color = _rnd_color.next_rgba32();
+      BLRgba32 color = next_color();
       if (op == RenderOp::kStroke)
         _context.stroke_polygon(points, complexity, color);
       else
@@ -494,56 +740,181 @@ void Blend2DModule::render_polygon(RenderOp op, uint32_t complexity) {
 void Blend2DModule::render_shape(RenderOp op, ShapeData shape) {
   BLSizeI bounds(_params.screen_w - _params.shape_size, _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
+  ShapePathMode shape_path = _params.shape_path;
   double wh = double(_params.shape_size);
 
-  BLPath path;
-  ShapeIterator it(shape);
+  BLPath& path = _shape_path;
+  BLPattern pattern;
+  BLGradient gradient(_gradient_type);
 
-  while (it.has_command()) {
-    if (it.is_move_to()) {
-      path.move_to(it.vertex(0));
+  _context.set_fill_rule(op == RenderOp::kFillEvenOdd ? BL_FILL_RULE_EVEN_ODD : BL_FILL_RULE_NON_ZERO);
+  gradient.set_extend_mode(_gradient_extend);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base;
+    BLPoint offset(0, 0);
+    const BLPath* p = &path;
+
+    if (shape_path == ShapePathMode::kCached) {
+      uint32_t index = next_cached_shape();
+      base = _cached_shape_origins[index];
+      p = &_cached_paths[index];
     }
-    else if (it.is_line_to()) {
-      path.line_to(it.vertex(0));
+    else if (shape_path == ShapePathMode::kRebuild) {
+      base = next_origin(bounds);
+      path.clear();
+      add_shape_path(path, shape, wh, base);
     }
-    else if (it.is_quad_to()) {
-      path.quad_to(it.vertex(0), it.vertex(1));
+    else {
+      base = next_origin(bounds);
+      offset = base;
     }
-    else if (it.is_cubic_to()) {
-      path.cubic_to(it.vertex(0), it.vertex(1), it.vertex(2));
+
+    if (style == StyleKind::kSolid) {
+      BLRgba32 color = next_color();
+      if (op == RenderOp::kStroke)
+        _context.stroke_path(offset, *p, color);
+      else
+        _context.fill_path(offset, *p, color);
     }
     else {
-      path.close();
+      BLRect rect(base.x, base.y, wh, wh);
+      const auto& obj = setup_style(rect, style, gradient, pattern);
+
+      if (op == RenderOp::kStroke)
+        _context.stroke_path(offset, *p, obj);
+      else
+        _context.fill_path(offset, *p, obj);
+    }
+  }
+}
+
+template<typename StyleT>
+inline void Blend2DModule::render_text_lines(const BLPoint& pos, TextKind kind, const TextData& text, const StyleT& style) {
+  if (kind == TextKind::kGlyphRun) {
+    _context.fill_glyph_run(pos, _font, _glyph_buffer.glyph_run(), style);
+  }
+  else {
+    double line_height = double(_params.shape_size) * kTextLineHeight;
+    for (size_t i = 0; i < text.line_count; i++) {
+      _context.fill_utf8_text(BLPoint(pos.x, pos.y + line_height * double(i)), _font, text.lines[i], SIZE_MAX, style);
     }
-    it.next();
   }
+}
 
-  path.transform(BLMatrix2D::make_scaling(wh, wh));
+void Blend2DModule::render_text(TextKind kind) {
+  BLSizeI bounds(_params.screen_w - _params.shape_size,
+                 _params.screen_h - _params.shape_size);
+  StyleKind style = _params.style;
+  double wh = double(_params.shape_size);
+
+  TextData text;
+  get_text_data(text, kind);
 
   BLPattern pattern;
   BLGradient gradient(_gradient_type);
+  gradient.set_extend_mode(_gradient_extend);
 
-  _context.set_fill_rule(op == RenderOp::kFillEvenOdd ? BL_FILL_RULE_EVEN_ODD : BL_FILL_RULE_NON_ZERO);
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base(next_origin(bounds));
+    BLPoint pos(base.x, base.y + wh);
+
+    if (style == StyleKind::kSolid)
+      render_text_lines(pos, kind, text, next_color());
+    else
+      render_text_lines(pos, kind, text, setup_style(BLRect(base.x, base.y, wh, wh), style, gradient, pattern));
+  }
+}
+
+void Blend2DModule::render_blit_scaled(BLSizeI dst_size, bool fractional) {
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_blit_rect(dst_size, fractional));
+    const BLImage& sprite = _sprites[nextSpriteId()];
+
+    if (fractional)
+      _context.blit_image(rect, sprite);
+    else
+      _context.blit_image(BLRectI(int(rect.x), int(rect.y), dst_size.w, dst_size.h), sprite);
+  }
+}
+
+void Blend2DModule::render_rect_clip(ClipMode mode) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  BLPattern pattern;
+  BLGradient gradient(_gradient_type);
   gradient.set_extend_mode(_gradient_extend);
 
+  if (mode == ClipMode::kStatic) {
+    _context.save();
+    _context.clip_to_rect(static_clip_rect());
+  }
+
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLRect rect(next_rect(bounds, wh, wh));
 
-    if (style == StyleKind::kSolid) {
-      BLRgba32 color = _rnd_color.next_rgba32();
-      if (op == RenderOp::kStroke)
-        _context.stroke_path(base, path, color);
-      else
-        _context.fill_path(base, path, color);
+    if (mode == ClipMode::kNested) {
+      _context.save();
+      _context.clip_to_rect(clip_outer_rect(rect));
+      _context.save();
+      _context.clip_to_rect(clip_inner_rect(rect));
+    }
+    else if (mode == ClipMode::kPerCall) {
+      _context.clip_to_rect(clip_call_rect(rect));
     }
-    else {
-      BLRect rect(base.x, base.y, wh, wh);
-      const auto& obj = setup_style(rect, style, gradient, pattern);
 
-      if (op == RenderOp::kStroke)
-        _context.stroke_path(base, path, obj);
-      else
-        _context.fill_path(base, path, obj);
+    if (style == StyleKind::kSolid)
+      _context.fill_rect(rect, next_color());
+    else
+      _context.fill_rect(rect, setup_style(rect, style, gradient, pattern));
+
+    if (mode == ClipMode::kNested) {
+      _context.restore();
+      _context.restore();
+    }
+    else if (mode == ClipMode::kPerCall) {
+      _context.restore_clipping();
+    }
+  }
+
+  if (mode == ClipMode::kStatic)
+    _context.restore();
+}
+
+void Blend2DModule::render_gradient_stops(uint32_t stop_count, bool reuse) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  BLGradient gradient(_gradient_type);
+  gradient.set_extend_mode(_gradient_extend);
+
+  if (reuse) {
+    set_gradient_values(gradient, BLRect(0, 0, wh, wh), style);
+    for (uint32_t i = 0; i < stop_count; i++)
+      gradient.add_stop(gradient_stop_offset(i, stop_count), _gradient_colors[i]);
+
+    for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+
+      _context.translate(rect.x, rect.y);
+      _context.fill_rect(BLRect(0, 0, wh, wh), gradient);
+      _context.reset_transform();
+    }
+  }
+  else {
+    for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+
+      set_gradient_values(gradient, rect, style);
+      gradient.reset_stops();
+      gradient.add_stop(0.0, next_color());
+      for (uint32_t j = 1; j < stop_count; j++)
+        gradient.add_stop(gradient_stop_offset(j, stop_count), _gradient_colors[j]);
+
+      _context.fill_rect(rect, gradient);
     }
   }
 }
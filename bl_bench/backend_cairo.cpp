@@ -9,8 +9,17 @@
 #include "backend_cairo.h"
 
 #include <algorithm>
+#include <vector>
 #include <cairo.h>
 
+// Text tests need cairo-ft to create a font face from the embedded font data.
+#if defined(BLEND2D_APPS_ENABLE_CAIRO_FT) && CAIRO_HAS_FT_FONT
+  #define BLBENCH_CAIRO_HAS_TEXT
+  #include <cairo-ft.h>
+  #include <ft2build.h>
+  #include FT_FREETYPE_H
+#endif
+
 namespace blbench {
 
 static inline double u8_to_unit(int x) {
@@ -60,6 +69,26 @@ static uint32_t to_cairo_operator(uint32_t comp_op) {
   }
 }
 
+static uint32_t to_cairo_line_join(StrokeJoin join) {
+  switch (join) {
+    case StrokeJoin::kRound: return CAIRO_LINE_JOIN_ROUND;
+    case StrokeJoin::kBevel: return CAIRO_LINE_JOIN_BEVEL;
+
+    default:
+      return CAIRO_LINE_JOIN_MITER;
+  }
+}
+
+static uint32_t to_cairo_line_cap(StrokeCap cap) {
+  switch (cap) {
+    case StrokeCap::kRound : return CAIRO_LINE_CAP_ROUND;
+    case StrokeCap::kSquare: return CAIRO_LINE_CAP_SQUARE;
+
+    default:
+      return CAIRO_LINE_CAP_BUTT;
+  }
+}
+
 static void round_rect(cairo_t* ctx, const BLRect& rect, double radius) {
   double rw2 = rect.w * 0.5;
   double rh2 = rect.h * 0.5;
@@ -92,6 +121,45 @@ static void round_rect(cairo_t* ctx, const BLRect& rect, double radius) {
   cairo_close_path(ctx);
 }
 
+// Adds `shape` scaled by `scale` and translated by `offset` to the current path of `ctx`.
+static void add_shape_path(cairo_t* ctx, ShapeData shape, double scale, const BLPoint& offset) {
+  double x = offset.x;
+  double y = offset.y;
+
+  ShapeIterator it(shape);
+  while (it.has_command()) {
+    if (it.is_move_to()) {
+      cairo_move_to(ctx, x + it.x(0) * scale, y + it.y(0) * scale);
+    }
+    else if (it.is_line_to()) {
+      cairo_line_to(ctx, x + it.x(0) * scale, y + it.y(0) * scale);
+    }
+    else if (it.is_quad_to()) {
+      double x0 = x + it.x(-1) * scale;
+      double y0 = y + it.y(-1) * scale;
+      double x1 = x + it.x(0) * scale;
+      double y1 = y + it.y(0) * scale;
+      double x2 = x + it.x(1) * scale;
+      double y2 = y + it.y(1) * scale;
+
+      cairo_curve_to(ctx,
+        (2.0 / 3.0) * x1 + (1.0 / 3.0) * x0, (2.0 / 3.0) * y1 + (1.0 / 3.0) * y0,
+        (2.0 / 3.0) * x1 + (1.0 / 3.0) * x2, (2.0 / 3.0) * y1 + (1.0 / 3.0) * y2,
+        x2, y2);
+    }
+    else if (it.is_cubic_to()) {
+      cairo_curve_to(ctx,
+        x + it.x(0) * scale, y + it.y(0) * scale,
+        x + it.x(1) * scale, y + it.y(1) * scale,
+        x + it.x(2) * scale, y + it.y(2) * scale);
+    }
+    else {
+      cairo_close_path(ctx);
+    }
+    it.next();
+  }
+}
+
 struct CairoModule : public Backend {
   cairo_surface_t* _cairo_surface {};
   cairo_surface_t* _cairo_sprites[kBenchNumSprites] {};
@@ -101,6 +169,20 @@ struct CairoModule : public Backend {
   uint32_t _pattern_extend {};
   uint32_t _pattern_filter {};
 
+  // Initialized by before_run() of shape tests - the path to replay and paths of ShapePathMode::kCached.
+  cairo_path_t* _replay_path {};
+  std::vector<cairo_path_t*> _cached_paths;
+
+#if defined(BLBENCH_CAIRO_HAS_TEXT)
+  // Created by the first text test.
+  FT_Library _ft_library {};
+  FT_Face _ft_face {};
+  cairo_font_face_t* _cairo_font_face {};
+
+  // Glyphs of TextKind::kGlyphRun shaped by before_run().
+  std::vector<cairo_glyph_t> _glyphs;
+#endif
+
   CairoModule();
   ~CairoModule() override;
 
@@ -109,8 +191,14 @@ struct CairoModule : public Backend {
   template<typename RectT>
   void setup_style(StyleKind style, const RectT& rect);
 
+  cairo_pattern_t* create_gradient(StyleKind style, const BLRect& rect, uint32_t stop_count, BLRgba32 first_color);
+
   bool supports_comp_op(BLCompOp comp_op) const override;
   bool supports_style(StyleKind style) const override;
+  bool supports_format(BLFormat format) const override;
+  bool supports_test(TestKind test) const override;
+  bool supports_stroke(StrokeKind stroke) const override;
+  bool supports_shape_path(ShapePathMode shape_path) const override;
 
   void before_run() override;
   void flush() override;
@@ -118,17 +206,36 @@ struct CairoModule : public Backend {
 
   void render_rect_a(RenderOp op) override;
   void render_rect_f(RenderOp op) override;
+  void render_rect_a_batch(RenderOp op) override;
+  void render_rect_f_batch(RenderOp op) override;
   void render_rect_rotated(RenderOp op) override;
   void render_round_f(RenderOp op) override;
   void render_round_rotated(RenderOp op) override;
-  void render_polygon(RenderOp op, uint32_t complexity) override;
+  void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) override;
   void render_shape(RenderOp op, ShapeData shape) override;
+  void render_text(TextKind kind) override;
+  void render_blit_scaled(BLSizeI dst_size, bool fractional) override;
+  void render_rect_clip(ClipMode mode) override;
+  void render_gradient_stops(uint32_t stop_count, bool reuse) override;
 };
 
 CairoModule::CairoModule() {
   strcpy(_name, "Cairo");
 }
-CairoModule::~CairoModule() {}
+
+CairoModule::~CairoModule() {
+#if defined(BLBENCH_CAIRO_HAS_TEXT)
+  // The FreeType face must outlive the cairo font face created for it.
+  if (_cairo_font_face)
+    cairo_font_face_destroy(_cairo_font_face);
+
+  if (_ft_face)
+    FT_Done_Face(_ft_face);
+
+  if (_ft_library)
+    FT_Done_FreeType(_ft_library);
+#endif
+}
 
 void CairoModule::serialize_info(JSONBuilder& json) const {
   json.before_record()
@@ -140,7 +247,7 @@ template<typename RectT>
 void CairoModule::setup_style(StyleKind style, const RectT& rect) {
   switch (style) {
     case StyleKind::kSolid: {
-      BLRgba32 c(_rnd_color.next_rgba32());
+      BLRgba32 c(next_color());
       cairo_set_source_rgba(_cairo_ctx, u8_to_unit(c.r()), u8_to_unit(c.g()), u8_to_unit(c.b()), u8_to_unit(c.a()));
       return;
     }
@@ -154,9 +261,9 @@ void CairoModule::setup_style(StyleKind style, const RectT& rect) {
       double x = rect.x;
       double y = rect.y;
 
-      BLRgba32 c0(_rnd_color.next_rgba32());
-      BLRgba32 c1(_rnd_color.next_rgba32());
-      BLRgba32 c2(_rnd_color.next_rgba32());
+      BLRgba32 c0(next_color());
+      BLRgba32 c1(next_color());
+      BLRgba32 c2(next_color());
 
       cairo_pattern_t* pattern {};
       if (style < StyleKind::kRadialPad) {
@@ -213,6 +320,41 @@ void CairoModule::setup_style(StyleKind style, const RectT& rect) {
   }
 }
 
+// Creates a gradient of `style` spanning `rect` having `stop_count` stops of `_gradient_colors` except the first stop,
+// which uses `first_color`. The geometry is the same as used by `setup_style()`.
+cairo_pattern_t* CairoModule::create_gradient(StyleKind style, const BLRect& rect, uint32_t stop_count, BLRgba32 first_color) {
+  cairo_pattern_t* pattern {};
+  bool reversed = false;
+
+  if (style < StyleKind::kRadialPad) {
+    double x0 = rect.x + rect.w * 0.2;
+    double y0 = rect.y + rect.h * 0.2;
+    double x1 = rect.x + rect.w * 0.8;
+    double y1 = rect.y + rect.h * 0.8;
+    pattern = cairo_pattern_create_linear(x0, y0, x1, y1);
+  }
+  else {
+    double x = rect.x + rect.w / 2.0;
+    double y = rect.y + rect.h / 2.0;
+    double r = (rect.w + rect.h) / 4.0;
+    pattern = cairo_pattern_create_radial(x, y, r, x - r / 2, y - r / 2, 0.0);
+
+    // Color stops in Cairo's radial gradient are reverse to Blend/Qt.
+    reversed = true;
+  }
+
+  for (uint32_t i = 0; i < stop_count; i++) {
+    uint32_t index = reversed ? stop_count - 1u - i : i;
+    double offset = gradient_stop_offset(i, stop_count);
+    BLRgba32 c = index ? _gradient_colors[index] : first_color;
+
+    cairo_pattern_add_color_stop_rgba(pattern, offset, u8_to_unit(c.r()), u8_to_unit(c.g()), u8_to_unit(c.b()), u8_to_unit(c.a()));
+  }
+
+  cairo_pattern_set_extend(pattern, cairo_extend_t(_pattern_extend));
+  return pattern;
+}
+
 bool CairoModule::supports_comp_op(BLCompOp comp_op) const {
   return to_cairo_operator(comp_op) != 0xFFFFFFFFu;
 }
@@ -229,6 +371,26 @@ bool CairoModule::supports_style(StyleKind style) const {
          style == StyleKind::kPatternBI     ;
 }
 
+bool CairoModule::supports_format(BLFormat format) const {
+  return to_cairo_format(format) != 0xFFFFFFFFu;
+}
+
+bool CairoModule::supports_test(TestKind test) const {
+#if defined(BLBENCH_CAIRO_HAS_TEXT)
+  return true;
+#else
+  return !is_text_test(test);
+#endif
+}
+
+bool CairoModule::supports_stroke(StrokeKind stroke) const {
+  return true;
+}
+
+bool CairoModule::supports_shape_path(ShapePathMode shape_path) const {
+  return true;
+}
+
 void CairoModule::before_run() {
   int w = int(_params.screen_w);
   int h = int(_params.screen_h);
@@ -280,7 +442,24 @@ void CairoModule::before_run() {
   cairo_fill(_cairo_ctx);
 
   cairo_set_operator(_cairo_ctx, cairo_operator_t(to_cairo_operator(_params.comp_op)));
-  cairo_set_line_width(_cairo_ctx, _params.stroke_width);
+
+  const StrokeOptions& stroke = stroke_options_of(_params.stroke);
+  cairo_set_line_width(_cairo_ctx, stroke.width);
+  cairo_set_line_join(_cairo_ctx, cairo_line_join_t(to_cairo_line_join(stroke.join)));
+  cairo_set_line_cap(_cairo_ctx, cairo_line_cap_t(to_cairo_line_cap(stroke.cap)));
+  cairo_set_miter_limit(_cairo_ctx, kBenchMiterLimit);
+
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 18, 0)
+  cairo_set_hairline(_cairo_ctx, stroke.hairline);
+#endif
+
+  if (stroke.is_dashed()) {
+    double dashes[2] = { stroke.dash_on, stroke.dash_off };
+    cairo_set_dash(_cairo_ctx, dashes, 2, 0.0);
+  }
+  else {
+    cairo_set_dash(_cairo_ctx, nullptr, 0, 0.0);
+  }
 
   // Setup globals.
   _pattern_extend = CAIRO_EXTEND_REPEAT;
@@ -301,6 +480,49 @@ void CairoModule::before_run() {
     case StyleKind::kConic:
       break;
   }
+
+  // No idea who invented this, but you need a `cairo_t` to create a `cairo_path_t`.
+  if (needs_replay_path()) {
+    add_shape_path(_cairo_ctx, _cached_shape, double(_params.shape_size), BLPoint(0, 0));
+    _replay_path = cairo_copy_path(_cairo_ctx);
+    cairo_new_path(_cairo_ctx);
+  }
+
+  for (const BLPoint& origin : _cached_shape_origins) {
+    add_shape_path(_cairo_ctx, _cached_shape, double(_params.shape_size), origin);
+    _cached_paths.push_back(cairo_copy_path(_cairo_ctx));
+    cairo_new_path(_cairo_ctx);
+  }
+
+#if defined(BLBENCH_CAIRO_HAS_TEXT)
+  if (is_text_test(_params.testKind)) {
+    if (!_cairo_font_face) {
+      size_t font_data_size;
+      const uint8_t* font_data = get_text_font_data(&font_data_size);
+
+      FT_Init_FreeType(&_ft_library);
+      FT_New_Memory_Face(_ft_library, font_data, FT_Long(font_data_size), 0, &_ft_face);
+      _cairo_font_face = cairo_ft_font_face_create_for_ft_face(_ft_face, 0);
+    }
+
+    cairo_set_font_face(_cairo_ctx, _cairo_font_face);
+    cairo_set_font_size(_cairo_ctx, double(_params.shape_size));
+
+    _glyphs.clear();
+    if (_params.testKind == TestKind::kFillGlyphRun) {
+      TextData text;
+      get_text_data(text, TextKind::kGlyphRun);
+
+      cairo_glyph_t* glyphs = nullptr;
+      int glyph_count = 0;
+
+      cairo_scaled_font_text_to_glyphs(cairo_get_scaled_font(_cairo_ctx), 0.0, 0.0, text.lines[0], -1,
+                                       &glyphs, &glyph_count, nullptr, nullptr, nullptr);
+      _glyphs.assign(glyphs, glyphs + glyph_count);
+      cairo_glyph_free(glyphs);
+    }
+  }
+#endif
 }
 
 void CairoModule::flush() {
@@ -308,6 +530,16 @@ void CairoModule::flush() {
 }
 
 void CairoModule::after_run() {
+  // Free the replayed and cached paths.
+  if (_replay_path) {
+    cairo_path_destroy(_replay_path);
+    _replay_path = nullptr;
+  }
+
+  for (cairo_path_t* path : _cached_paths)
+    cairo_path_destroy(path);
+  _cached_paths.clear();
+
   // Free the surface & the context.
   cairo_destroy(_cairo_ctx);
   cairo_surface_destroy(_cairo_surface);
@@ -329,7 +561,7 @@ void CairoModule::render_rect_a(RenderOp op) {
   int wh = _params.shape_size;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
+    BLRectI rect(next_rect_i(bounds, wh, wh));
     setup_style<BLRectI>(style, rect);
 
     if (op == RenderOp::kStroke) {
@@ -350,7 +582,7 @@ void CairoModule::render_rect_f(RenderOp op) {
   double wh = _params.shape_size;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+    BLRect rect(next_rect(bounds, wh, wh));
 
     setup_style<BLRect>(style, rect);
     cairo_rectangle(_cairo_ctx, rect.x, rect.y, rect.w, rect.h);
@@ -364,6 +596,57 @@ void CairoModule::render_rect_f(RenderOp op) {
   }
 }
 
+void CairoModule::render_rect_a_batch(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+
+  int wh = _params.shape_size;
+
+  // All rectangles of a batch are added to the current path, which is then filled or stroked at once.
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    for (uint32_t j = 0; j < n; j++) {
+      BLRectI rect(next_rect_i(bounds, wh, wh));
+      cairo_rectangle(_cairo_ctx, rect.x, rect.y, rect.w, rect.h);
+    }
+
+    setup_style<BLRectI>(style, BLRectI(0, 0, bounds.w, bounds.h));
+
+    if (op == RenderOp::kStroke) {
+      cairo_stroke(_cairo_ctx);
+    }
+    else {
+      cairo_fill(_cairo_ctx);
+    }
+  }
+}
+
+void CairoModule::render_rect_f_batch(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+
+  double wh = _params.shape_size;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    for (uint32_t j = 0; j < n; j++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+      cairo_rectangle(_cairo_ctx, rect.x, rect.y, rect.w, rect.h);
+    }
+
+    setup_style<BLRect>(style, BLRect(0, 0, bounds.w, bounds.h));
+
+    if (op == RenderOp::kStroke) {
+      cairo_stroke(_cairo_ctx);
+    }
+    else {
+      cairo_fill(_cairo_ctx);
+    }
+  }
+}
+
 void CairoModule::render_rect_rotated(RenderOp op) {
   BLSize bounds(_params.screen_w, _params.screen_h);
   StyleKind style = _params.style;
@@ -371,10 +654,10 @@ void CairoModule::render_rect_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+    BLRect rect(next_rect(bounds, wh, wh));
 
     cairo_translate(_cairo_ctx, cx, cy);
     cairo_rotate(_cairo_ctx, angle);
@@ -392,6 +675,8 @@ void CairoModule::render_rect_rotated(RenderOp op) {
 
     cairo_identity_matrix(_cairo_ctx);
   }
+
+  _rotation_angle = angle;
 }
 
 void CairoModule::render_round_f(RenderOp op) {
@@ -401,8 +686,8 @@ void CairoModule::render_round_f(RenderOp op) {
   double wh = _params.shape_size;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect(next_rect(bounds, wh, wh));
+    double radius = next_radius();
 
     setup_style<BLRect>(style, rect);
     round_rect(_cairo_ctx, rect, radius);
@@ -423,11 +708,11 @@ void CairoModule::render_round_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect(next_rect(bounds, wh, wh));
+    double radius = next_radius();
 
     cairo_translate(_cairo_ctx, cx, cy);
     cairo_rotate(_cairo_ctx, angle);
@@ -445,9 +730,11 @@ void CairoModule::render_round_rotated(RenderOp op) {
 
     cairo_identity_matrix(_cairo_ctx);
   }
+
+  _rotation_angle = angle;
 }
 
-void CairoModule::render_polygon(RenderOp op, uint32_t complexity) {
+void CairoModule::render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
@@ -456,16 +743,14 @@ void CairoModule::render_polygon(RenderOp op, uint32_t complexity) {
   cairo_set_fill_rule(_cairo_ctx, op == RenderOp::kFillEvenOdd ? CAIRO_FILL_RULE_EVEN_ODD : CAIRO_FILL_RULE_WINDING);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base(next_origin(bounds));
 
-    double x = _rnd_coord.next_double(base.x, base.x + wh);
-    double y = _rnd_coord.next_double(base.y, base.y + wh);
+    BLPoint v = next_vertex(kind, base, wh, 0);
 
-    cairo_move_to(_cairo_ctx, x, y);
+    cairo_move_to(_cairo_ctx, v.x, v.y);
     for (uint32_t p = 1; p < complexity; p++) {
-      x = _rnd_coord.next_double(base.x, base.x + wh);
-      y = _rnd_coord.next_double(base.y, base.y + wh);
-      cairo_line_to(_cairo_ctx, x, y);
+      v = next_vertex(kind, base, wh, p);
+      cairo_line_to(_cairo_ctx, v.x, v.y);
     }
     setup_style<BLRect>(style, BLRect(base.x, base.y, wh, wh));
 
@@ -482,67 +767,192 @@ void CairoModule::render_shape(RenderOp op, ShapeData shape) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
+  ShapePathMode shape_path = _params.shape_path;
   double wh = double(_params.shape_size);
 
-  ShapeIterator it(shape);
-  while (it.has_command()) {
-    if (it.is_move_to()) {
-      cairo_move_to(_cairo_ctx, it.x(0) * wh, it.y(0) * wh);
+  cairo_set_fill_rule(_cairo_ctx, op == RenderOp::kFillEvenOdd ? CAIRO_FILL_RULE_EVEN_ODD : CAIRO_FILL_RULE_WINDING);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    if (shape_path == ShapePathMode::kCached) {
+      uint32_t index = next_cached_shape();
+      BLPoint base(_cached_shape_origins[index]);
+
+      setup_style<BLRect>(style, BLRect(base.x, base.y, wh, wh));
+      cairo_append_path(_cairo_ctx, _cached_paths[index]);
     }
-    else if (it.is_line_to()) {
-      cairo_line_to(_cairo_ctx, it.x(0) * wh, it.y(0) * wh);
+    else if (shape_path == ShapePathMode::kRebuild) {
+      BLPoint base(next_origin(bounds));
+
+      setup_style<BLRect>(style, BLRect(base.x, base.y, wh, wh));
+      add_shape_path(_cairo_ctx, shape, wh, base);
     }
-    else if (it.is_quad_to()) {
-      double x0 = it.x(-1) * wh;
-      double y0 = it.y(-1) * wh;
-      double x1 = it.x(0) * wh;
-      double y1 = it.y(0) * wh;
-      double x2 = it.x(1) * wh;
-      double y2 = it.y(1) * wh;
-
-      cairo_curve_to(_cairo_ctx,
-        (2.0 / 3.0) * x1 + (1.0 / 3.0) * x0, (2.0 / 3.0) * y1 + (1.0 / 3.0) * y0,
-        (2.0 / 3.0) * x1 + (1.0 / 3.0) * x2, (2.0 / 3.0) * y1 + (1.0 / 3.0) * y2,
-        y1, y2);
+    else {
+      cairo_save(_cairo_ctx);
+
+      BLPoint base(next_origin(bounds));
+      setup_style<BLRect>(style, BLRect(base.x, base.y, wh, wh));
+
+      cairo_translate(_cairo_ctx, base.x, base.y);
+      cairo_append_path(_cairo_ctx, _replay_path);
     }
-    else if (it.is_cubic_to()) {
-      cairo_curve_to(_cairo_ctx,
-        it.x(0) * wh, it.y(0) * wh,
-        it.x(1) * wh, it.y(1) * wh,
-        it.x(2) * wh, it.y(2) * wh);
+
+    if (op == RenderOp::kStroke) {
+      cairo_stroke(_cairo_ctx);
     }
     else {
-      cairo_close_path(_cairo_ctx);
+      cairo_fill(_cairo_ctx);
     }
-    it.next();
+
+    if (shape_path == ShapePathMode::kReplay)
+      cairo_restore(_cairo_ctx);
   }
+}
 
-  // No idea who invented this, but you need a `cairo_t` to create a `cairo_path_t`.
-  cairo_path_t* path = cairo_copy_path(_cairo_ctx);
-  cairo_new_path(_cairo_ctx);
+void CairoModule::render_text(TextKind kind) {
+#if defined(BLBENCH_CAIRO_HAS_TEXT)
+  BLSizeI bounds(_params.screen_w - _params.shape_size,
+                 _params.screen_h - _params.shape_size);
+  StyleKind style = _params.style;
+  double wh = double(_params.shape_size);
+  double line_height = wh * kTextLineHeight;
 
-  cairo_set_fill_rule(_cairo_ctx, op == RenderOp::kFillEvenOdd ? CAIRO_FILL_RULE_EVEN_ODD : CAIRO_FILL_RULE_WINDING);
+  TextData text;
+  get_text_data(text, kind);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base(next_origin(bounds));
+    setup_style<BLRect>(style, BLRect(base.x, base.y, wh, wh));
+
+    if (kind == TextKind::kGlyphRun) {
+      // Glyph positions are relative to the origin of the run.
+      cairo_save(_cairo_ctx);
+      cairo_translate(_cairo_ctx, base.x, base.y + wh);
+      cairo_show_glyphs(_cairo_ctx, _glyphs.data(), int(_glyphs.size()));
+      cairo_restore(_cairo_ctx);
+    }
+    else {
+      for (size_t line = 0; line < text.line_count; line++) {
+        cairo_move_to(_cairo_ctx, base.x, base.y + wh + line_height * double(line));
+        cairo_show_text(_cairo_ctx, text.lines[line]);
+      }
+    }
+  }
+#else
+  // Not supported, see supports_test().
+  (void)kind;
+#endif
+}
+
+void CairoModule::render_blit_scaled(BLSizeI dst_size, bool fractional) {
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_blit_rect(dst_size, fractional));
+    cairo_surface_t* sprite = _cairo_sprites[nextSpriteId()];
+
+    // Matrix associated with cairo_pattern_t is inverse to Blend/Qt (maps the destination to the sprite).
+    cairo_matrix_t matrix;
+    cairo_matrix_init_scale(&matrix,
+      double(cairo_image_surface_get_width(sprite)) / rect.w,
+      double(cairo_image_surface_get_height(sprite)) / rect.h);
+    cairo_matrix_translate(&matrix, -rect.x, -rect.y);
+
+    cairo_pattern_t* pattern = cairo_pattern_create_for_surface(sprite);
+    cairo_pattern_set_matrix(pattern, &matrix);
+    cairo_pattern_set_extend(pattern, CAIRO_EXTEND_PAD);
+    cairo_pattern_set_filter(pattern, cairo_filter_t(_pattern_filter));
+
+    cairo_set_source(_cairo_ctx, pattern);
+    cairo_pattern_destroy(pattern);
+
+    cairo_rectangle(_cairo_ctx, rect.x, rect.y, rect.w, rect.h);
+    cairo_fill(_cairo_ctx);
+  }
+}
+
+void CairoModule::render_rect_clip(ClipMode mode) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  if (mode == ClipMode::kStatic) {
+    BLRectI clip = static_clip_rect();
+
     cairo_save(_cairo_ctx);
+    cairo_rectangle(_cairo_ctx, clip.x, clip.y, clip.w, clip.h);
+    cairo_clip(_cairo_ctx);
+  }
 
-    BLPoint base(_rnd_coord.nextPoint(bounds));
-    setup_style<BLRect>(style, BLRect(base.x, base.y, wh, wh));
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_rect(bounds, wh, wh));
 
-    cairo_translate(_cairo_ctx, base.x, base.y);
-    cairo_append_path(_cairo_ctx, path);
+    if (mode == ClipMode::kNested) {
+      BLRect outer = clip_outer_rect(rect);
+      BLRect inner = clip_inner_rect(rect);
 
-    if (op == RenderOp::kStroke) {
-      cairo_stroke(_cairo_ctx);
+      cairo_save(_cairo_ctx);
+      cairo_rectangle(_cairo_ctx, outer.x, outer.y, outer.w, outer.h);
+      cairo_clip(_cairo_ctx);
+
+      cairo_save(_cairo_ctx);
+      cairo_rectangle(_cairo_ctx, inner.x, inner.y, inner.w, inner.h);
+      cairo_clip(_cairo_ctx);
     }
-    else {
-      cairo_fill(_cairo_ctx);
+    else if (mode == ClipMode::kPerCall) {
+      BLRect clip = clip_call_rect(rect);
+
+      cairo_reset_clip(_cairo_ctx);
+      cairo_rectangle(_cairo_ctx, clip.x, clip.y, clip.w, clip.h);
+      cairo_clip(_cairo_ctx);
     }
 
+    setup_style<BLRect>(style, rect);
+    cairo_rectangle(_cairo_ctx, rect.x, rect.y, rect.w, rect.h);
+    cairo_fill(_cairo_ctx);
+
+    if (mode == ClipMode::kNested) {
+      cairo_restore(_cairo_ctx);
+      cairo_restore(_cairo_ctx);
+    }
+  }
+
+  if (mode == ClipMode::kStatic)
     cairo_restore(_cairo_ctx);
+  else if (mode == ClipMode::kPerCall)
+    cairo_reset_clip(_cairo_ctx);
+}
+
+void CairoModule::render_gradient_stops(uint32_t stop_count, bool reuse) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  if (reuse) {
+    cairo_pattern_t* pattern = create_gradient(style, BLRect(0, 0, wh, wh), stop_count, _gradient_colors[0]);
+
+    for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+
+      // The source pattern is locked to the user space when it's set, thus it must be set after translating.
+      cairo_translate(_cairo_ctx, rect.x, rect.y);
+      cairo_set_source(_cairo_ctx, pattern);
+      cairo_rectangle(_cairo_ctx, 0, 0, wh, wh);
+      cairo_fill(_cairo_ctx);
+      cairo_identity_matrix(_cairo_ctx);
+    }
+
+    cairo_pattern_destroy(pattern);
   }
+  else {
+    for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+      cairo_pattern_t* pattern = create_gradient(style, rect, stop_count, next_color());
+
+      cairo_set_source(_cairo_ctx, pattern);
+      cairo_pattern_destroy(pattern);
 
-  cairo_path_destroy(path);
+      cairo_rectangle(_cairo_ctx, rect.x, rect.y, rect.w, rect.h);
+      cairo_fill(_cairo_ctx);
+    }
+  }
 }
 
 Backend* create_cairo_backend() {
@@ -53,6 +53,26 @@ static CGBlendMode to_cg_blend_mode(BLCompOp comp_op) noexcept {
   }
 }
 
+static CGLineJoin to_cg_line_join(StrokeJoin join) noexcept {
+  switch (join) {
+    case StrokeJoin::kRound: return kCGLineJoinRound;
+    case StrokeJoin::kBevel: return kCGLineJoinBevel;
+
+    default:
+      return kCGLineJoinMiter;
+  }
+}
+
+static CGLineCap to_cg_line_cap(StrokeCap cap) noexcept {
+  switch (cap) {
+    case StrokeCap::kRound : return kCGLineCapRound;
+    case StrokeCap::kSquare: return kCGLineCapSquare;
+
+    default:
+      return kCGLineCapButt;
+  }
+}
+
 template<typename RectT>
 static inline CGRect to_cg_rect(const RectT& rect) noexcept {
   return CGRectMake(CGFloat(rect.x), CGFloat(rect.y), CGFloat(rect.w), CGFloat(rect.h));
@@ -85,12 +105,57 @@ static void flipImage(BLImage& img) noexcept {
   }
 }
 
+// Adds `shape` scaled by `scale` and translated by `offset` to `path`.
+static void add_shape_path(CGMutablePathRef path, ShapeData shape, double scale, const BLPoint& offset) {
+  double x = offset.x;
+  double y = offset.y;
+
+  ShapeIterator it(shape);
+  while (it.has_command()) {
+    if (it.is_move_to()) {
+      CGPathMoveToPoint(
+        path,
+        nullptr,
+        x + it.x(0) * scale, y + it.y(0) * scale);
+    }
+    else if (it.is_line_to()) {
+      CGPathAddLineToPoint(
+        path,
+        nullptr,
+        x + it.x(0) * scale, y + it.y(0) * scale);
+    }
+    else if (it.is_quad_to()) {
+      CGPathAddQuadCurveToPoint(
+        path,
+        nullptr,
+        x + it.x(0) * scale, y + it.y(0) * scale,
+        x + it.x(1) * scale, y + it.y(1) * scale);
+    }
+    else if (it.is_cubic_to()) {
+      CGPathAddCurveToPoint(
+        path,
+        nullptr,
+        x + it.x(0) * scale, y + it.y(0) * scale,
+        x + it.x(1) * scale, y + it.y(1) * scale,
+        x + it.x(2) * scale, y + it.y(2) * scale);
+    }
+    else {
+      CGPathCloseSubpath(path);
+    }
+    it.next();
+  }
+}
+
 struct CoreGraphicsModule : public Backend {
   CGImageRef _cg_sprites[kBenchNumSprites] {};
 
   CGColorSpaceRef _cg_colorspace {};
   CGContextRef _cg_ctx {};
 
+  // Initialized by before_run() of shape tests - the path to replay and paths of ShapePathMode::kCached.
+  CGMutablePathRef _replay_path {};
+  std::vector<CGMutablePathRef> _cached_paths;
+
   CoreGraphicsModule();
   ~CoreGraphicsModule() override;
 
@@ -98,6 +163,10 @@ struct CoreGraphicsModule : public Backend {
 
   bool supports_comp_op(BLCompOp comp_op) const override;
   bool supports_style(StyleKind style) const override;
+  bool supports_format(BLFormat format) const override;
+  bool supports_test(TestKind test) const override;
+  bool supports_stroke(StrokeKind stroke) const override;
+  bool supports_shape_path(ShapePathMode shape_path) const override;
 
   void before_run() override;
   void flush() override;
@@ -118,11 +187,17 @@ struct CoreGraphicsModule : public Backend {
 
   void render_rect_a(RenderOp op) override;
   void render_rect_f(RenderOp op) override;
+  void render_rect_a_batch(RenderOp op) override;
+  void render_rect_f_batch(RenderOp op) override;
   void render_rect_rotated(RenderOp op) override;
   void render_round_f(RenderOp op) override;
   void render_round_rotated(RenderOp op) override;
-  void render_polygon(RenderOp op, uint32_t complexity) override;
+  void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) override;
   void render_shape(RenderOp op, ShapeData shape) override;
+  void render_text(TextKind kind) override;
+  void render_blit_scaled(BLSizeI dst_size, bool fractional) override;
+  void render_rect_clip(ClipMode mode) override;
+  void render_gradient_stops(uint32_t stop_count, bool reuse) override;
 };
 
 CoreGraphicsModule::CoreGraphicsModule() {
@@ -169,6 +244,23 @@ bool CoreGraphicsModule::supports_style(StyleKind style) const {
          style == StyleKind::kPatternBI ;
 }
 
+bool CoreGraphicsModule::supports_format(BLFormat format) const {
+  return to_cg_bitmap_info(format) != 0;
+}
+
+bool CoreGraphicsModule::supports_test(TestKind test) const {
+  // Text and gradients of many stops are not implemented by this backend.
+  return !is_text_test(test) && !is_gradient_stop_test(test);
+}
+
+bool CoreGraphicsModule::supports_stroke(StrokeKind stroke) const {
+  return true;
+}
+
+bool CoreGraphicsModule::supports_shape_path(ShapePathMode shape_path) const {
+  return true;
+}
+
 void CoreGraphicsModule::before_run() {
   int w = int(_params.screen_w);
   int h = int(_params.screen_h);
@@ -176,6 +268,17 @@ void CoreGraphicsModule::before_run() {
 
   _cg_colorspace = CGColorSpaceCreateWithName(kCGColorSpaceGenericRGBLinear);
 
+  if (needs_replay_path()) {
+    _replay_path = CGPathCreateMutable();
+    add_shape_path(_replay_path, _cached_shape, double(_params.shape_size), BLPoint(0, 0));
+  }
+
+  for (const BLPoint& origin : _cached_shape_origins) {
+    CGMutablePathRef path = CGPathCreateMutable();
+    add_shape_path(path, _cached_shape, double(_params.shape_size), origin);
+    _cached_paths.push_back(path);
+  }
+
   // Initialize the sprites.
   for (uint32_t i = 0; i < kBenchNumSprites; i++) {
     BLImage& sprite = _sprites[i];
@@ -246,8 +349,16 @@ void CoreGraphicsModule::before_run() {
   CGContextSetBlendMode(_cg_ctx, to_cg_blend_mode(_params.comp_op));
   CGContextSetAllowsAntialiasing(_cg_ctx, true);
 
-  CGContextSetLineJoin(_cg_ctx, kCGLineJoinMiter);
-  CGContextSetLineWidth(_cg_ctx, CGFloat(_params.stroke_width));
+  const StrokeOptions& stroke = stroke_options_of(_params.stroke);
+  CGContextSetLineJoin(_cg_ctx, to_cg_line_join(stroke.join));
+  CGContextSetLineCap(_cg_ctx, to_cg_line_cap(stroke.cap));
+  CGContextSetMiterLimit(_cg_ctx, CGFloat(kBenchMiterLimit));
+  CGContextSetLineWidth(_cg_ctx, CGFloat(stroke.width));
+
+  if (stroke.is_dashed()) {
+    CGFloat dashes[2] = { CGFloat(stroke.dash_on), CGFloat(stroke.dash_off) };
+    CGContextSetLineDash(_cg_ctx, 0, dashes, 2);
+  }
 }
 
 void CoreGraphicsModule::flush() {
@@ -255,6 +366,15 @@ void CoreGraphicsModule::flush() {
 }
 
 void CoreGraphicsModule::after_run() {
+  if (_replay_path) {
+    CGPathRelease(_replay_path);
+    _replay_path = nullptr;
+  }
+
+  for (CGMutablePathRef path : _cached_paths)
+    CGPathRelease(path);
+  _cached_paths.clear();
+
   CGContextRelease(_cg_ctx);
   CGColorSpaceRelease(_cg_colorspace);
 
@@ -273,9 +393,9 @@ void CoreGraphicsModule::after_run() {
 }
 
 CGGradientRef CoreGraphicsModule::create_gradient(StyleKind style) noexcept {
-  BLRgba32 c0 = _rnd_color.next_rgba32();
-  BLRgba32 c1 = _rnd_color.next_rgba32();
-  BLRgba32 c2 = _rnd_color.next_rgba32();
+  BLRgba32 c0 = next_color();
+  BLRgba32 c1 = next_color();
+  BLRgba32 c2 = next_color();
 
   switch (style) {
     case StyleKind::kLinearPad:
@@ -318,9 +438,9 @@ CGGradientRef CoreGraphicsModule::create_gradient(StyleKind style) noexcept {
     }
 
     case StyleKind::kConic: {
-      BLRgba32 c0 = _rnd_color.next_rgba32();
-      BLRgba32 c1 = _rnd_color.next_rgba32();
-      BLRgba32 c2 = _rnd_color.next_rgba32();
+      BLRgba32 c0 = next_color();
+      BLRgba32 c1 = next_color();
+      BLRgba32 c2 = next_color();
 
       CGFloat components[16];
       to_cg_color_components(components +  0, c0);
@@ -345,7 +465,7 @@ CGGradientRef CoreGraphicsModule::create_gradient(StyleKind style) noexcept {
 
 BL_INLINE void CoreGraphicsModule::render_solid_path(RenderOp op) noexcept {
   CGFloat color[4];
-  to_cg_color_components(color, _rnd_color.next_rgba32());
+  to_cg_color_components(color, next_color());
 
   if (op == RenderOp::kStroke) {
     CGContextSetStrokeColor(_cg_ctx, color);
@@ -363,7 +483,7 @@ BL_INLINE void CoreGraphicsModule::render_solid_path(RenderOp op) noexcept {
 template<typename RectT>
 BL_INLINE void CoreGraphicsModule::render_solid_rect(const RectT& rect, RenderOp op) noexcept {
   CGFloat color[4];
-  to_cg_color_components(color, _rnd_color.next_rgba32());
+  to_cg_color_components(color, next_color());
 
   if (op == RenderOp::kStroke) {
     CGContextSetStrokeColor(_cg_ctx, color);
@@ -468,13 +588,13 @@ void CoreGraphicsModule::render_rect_a(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      render_solid_rect(_rnd_coord.next_rect_i(bounds, wh, wh), op);
+      render_solid_rect(next_rect_i(bounds, wh, wh), op);
     }
   }
   else if ((style == StyleKind::kPatternNN || style == StyleKind::kPatternBI) && op != RenderOp::kStroke) {
     CGFloat wh_f = CGFloat(wh);
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI r = _rnd_coord.next_rect_i(bounds, wh, wh);
+      BLRectI r = next_rect_i(bounds, wh, wh);
       uint32_t spriteId = nextSpriteId();
 
       CGContextDrawImage(_cg_ctx, CGRectMake(CGFloat(r.x), CGFloat(r.y), wh_f, wh_f), _cg_sprites[spriteId]);
@@ -482,7 +602,7 @@ void CoreGraphicsModule::render_rect_a(RenderOp op) {
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      render_styled_rect<true>(_rnd_coord.next_rect_i(bounds, wh, wh), style, op);
+      render_styled_rect<true>(next_rect_i(bounds, wh, wh), style, op);
     }
   }
 }
@@ -494,12 +614,74 @@ void CoreGraphicsModule::render_rect_f(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      render_solid_rect(_rnd_coord.next_rect(bounds, wh, wh), op);
+      render_solid_rect(next_rect(bounds, wh, wh), op);
     }
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      render_styled_rect<true>(_rnd_coord.next_rect(bounds, wh, wh), style, op);
+      render_styled_rect<true>(next_rect(bounds, wh, wh), style, op);
+    }
+  }
+}
+
+void CoreGraphicsModule::render_rect_a_batch(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  int wh = _params.shape_size;
+
+  CGRect rects[kBenchBatchSize];
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    for (uint32_t j = 0; j < n; j++)
+      rects[j] = to_cg_rect(next_rect_i(bounds, wh, wh));
+
+    if (style == StyleKind::kSolid && op != RenderOp::kStroke) {
+      CGFloat color[4];
+      to_cg_color_components(color, next_color());
+
+      CGContextSetFillColor(_cg_ctx, color);
+      CGContextFillRects(_cg_ctx, rects, n);
+    }
+    else {
+      CGContextAddRects(_cg_ctx, rects, n);
+
+      if (style == StyleKind::kSolid)
+        render_solid_path(op);
+      else
+        render_styled_path<true>(BLRectI(0, 0, bounds.w, bounds.h), style, op);
+    }
+  }
+}
+
+void CoreGraphicsModule::render_rect_f_batch(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  CGRect rects[kBenchBatchSize];
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    for (uint32_t j = 0; j < n; j++)
+      rects[j] = to_cg_rect(next_rect(bounds, wh, wh));
+
+    if (style == StyleKind::kSolid && op != RenderOp::kStroke) {
+      CGFloat color[4];
+      to_cg_color_components(color, next_color());
+
+      CGContextSetFillColor(_cg_ctx, color);
+      CGContextFillRects(_cg_ctx, rects, n);
+    }
+    else {
+      CGContextAddRects(_cg_ctx, rects, n);
+
+      if (style == StyleKind::kSolid)
+        render_solid_path(op);
+      else
+        render_styled_path<true>(BLRect(0, 0, bounds.w, bounds.h), style, op);
     }
   }
 }
@@ -511,10 +693,10 @@ void CoreGraphicsModule::render_rect_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+    BLRect rect(next_rect(bounds, wh, wh));
 
     CGContextSaveGState(_cg_ctx);
     CGContextTranslateCTM(_cg_ctx, CGFloat(cx), CGFloat(cy));
@@ -530,6 +712,8 @@ void CoreGraphicsModule::render_rect_rotated(RenderOp op) {
 
     CGContextRestoreGState(_cg_ctx);
   }
+
+  _rotation_angle = angle;
 }
 
 void CoreGraphicsModule::render_round_f(RenderOp op) {
@@ -538,8 +722,8 @@ void CoreGraphicsModule::render_round_f(RenderOp op) {
   double wh = _params.shape_size;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect(next_rect(bounds, wh, wh));
+    double radius = next_radius();
 
     CGPathRef path = CGPathCreateWithRoundedRect(
       CGRectMake(rect.x, rect.y, rect.w, rect.h),
@@ -567,11 +751,11 @@ void CoreGraphicsModule::render_round_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect(next_rect(bounds, wh, wh));
+    double radius = next_radius();
 
     CGContextSaveGState(_cg_ctx);
     CGContextTranslateCTM(_cg_ctx, CGFloat(cx), CGFloat(cy));
@@ -596,25 +780,25 @@ void CoreGraphicsModule::render_round_rotated(RenderOp op) {
     CGPathRelease(path);
     CGContextRestoreGState(_cg_ctx);
   }
+
+  _rotation_angle = angle;
 }
 
-void CoreGraphicsModule::render_polygon(RenderOp op, uint32_t complexity) {
+void CoreGraphicsModule::render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
   double wh = double(_params.shape_size);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base(next_origin(bounds));
 
-    double x = _rnd_coord.next_double(base.x, base.x + wh);
-    double y = _rnd_coord.next_double(base.y, base.y + wh);
+    BLPoint v = next_vertex(kind, base, wh, 0);
 
-    CGContextMoveToPoint(_cg_ctx, CGFloat(x), CGFloat(y));
+    CGContextMoveToPoint(_cg_ctx, CGFloat(v.x), CGFloat(v.y));
     for (uint32_t p = 1; p < complexity; p++) {
-      x = _rnd_coord.next_double(base.x, base.x + wh);
-      y = _rnd_coord.next_double(base.y, base.y + wh);
-      CGContextAddLineToPoint(_cg_ctx, CGFloat(x), CGFloat(y));
+      v = next_vertex(kind, base, wh, p);
+      CGContextAddLineToPoint(_cg_ctx, CGFloat(v.x), CGFloat(v.y));
     }
     CGContextClosePath(_cg_ctx);
 
@@ -622,7 +806,7 @@ void CoreGraphicsModule::render_polygon(RenderOp op, uint32_t complexity) {
       render_solid_path(op);
     }
     else {
-      render_styled_path<true>(BLRect(x, y, wh, wh), style, op);
+      render_styled_path<true>(BLRect(v.x, v.y, wh, wh), style, op);
     }
   }
 }
@@ -631,63 +815,111 @@ void CoreGraphicsModule::render_shape(RenderOp op, ShapeData shape) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
+  ShapePathMode shape_path = _params.shape_path;
   double wh = double(_params.shape_size);
 
-  CGMutablePathRef path = CGPathCreateMutable();
-  ShapeIterator it(shape);
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(0, 0, wh, wh);
 
-  while (it.has_command()) {
-    if (it.is_move_to()) {
-      CGPathMoveToPoint(
-        path,
-        nullptr,
-        it.x(0) * wh, it.y(0) * wh);
+    // The graphics state is saved even if the path is not translated as styled paths are rendered by clipping.
+    CGContextSaveGState(_cg_ctx);
+
+    if (shape_path == ShapePathMode::kCached) {
+      uint32_t index = next_cached_shape();
+      BLPoint base(_cached_shape_origins[index]);
+
+      rect.reset(base.x, base.y, wh, wh);
+      CGContextAddPath(_cg_ctx, _cached_paths[index]);
     }
-    else if (it.is_line_to()) {
-      CGPathAddLineToPoint(
-        path,
-        nullptr,
-        it.x(0) * wh, it.y(0) * wh);
+    else if (shape_path == ShapePathMode::kRebuild) {
+      BLPoint base(next_origin(bounds));
+      CGMutablePathRef rebuilt_path = CGPathCreateMutable();
+
+      add_shape_path(rebuilt_path, shape, wh, base);
+      rect.reset(base.x, base.y, wh, wh);
+
+      CGContextAddPath(_cg_ctx, rebuilt_path);
+      CGPathRelease(rebuilt_path);
     }
-    else if (it.is_quad_to()) {
-      CGPathAddQuadCurveToPoint(
-        path,
-        nullptr,
-        it.x(0) * wh, it.y(0) * wh,
-        it.x(1) * wh, it.y(1) * wh);
+    else {
+      BLPoint base(next_origin(bounds));
+
+      CGContextTranslateCTM(_cg_ctx, CGFloat(base.x), CGFloat(base.y));
+      CGContextAddPath(_cg_ctx, _replay_path);
     }
-    else if (it.is_cubic_to()) {
-      CGPathAddCurveToPoint(
-        path,
-        nullptr,
-        it.x(0) * wh, it.y(0) * wh,
-        it.x(1) * wh, it.y(1) * wh,
-        it.x(2) * wh, it.y(2) * wh);
+
+    if (style == StyleKind::kSolid) {
+      render_solid_path(op);
     }
     else {
-      CGPathCloseSubpath(path);
+      render_styled_path<false>(rect, style, op);
     }
-    it.next();
+
+    CGContextRestoreGState(_cg_ctx);
   }
+}
+
+void CoreGraphicsModule::render_text(TextKind kind) {
+  // Not supported, see supports_test().
+  (void)kind;
+}
 
+void CoreGraphicsModule::render_blit_scaled(BLSizeI dst_size, bool fractional) {
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLRect rect(next_blit_rect(dst_size, fractional));
+    uint32_t spriteId = nextSpriteId();
 
+    CGContextDrawImage(_cg_ctx, to_cg_rect(rect), _cg_sprites[spriteId]);
+  }
+}
+
+void CoreGraphicsModule::render_rect_clip(ClipMode mode) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  if (mode == ClipMode::kStatic) {
     CGContextSaveGState(_cg_ctx);
-    CGContextTranslateCTM(_cg_ctx, CGFloat(base.x), CGFloat(base.y));
-    CGContextAddPath(_cg_ctx, path);
+    CGContextClipToRect(_cg_ctx, to_cg_rect(static_clip_rect()));
+  }
 
-    if (style == StyleKind::kSolid) {
-      render_solid_path(op);
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_rect(bounds, wh, wh));
+
+    // CoreGraphics has no way to replace the clip, thus a clip that changes per call needs its own gstate.
+    if (mode == ClipMode::kNested) {
+      CGContextSaveGState(_cg_ctx);
+      CGContextClipToRect(_cg_ctx, to_cg_rect(clip_outer_rect(rect)));
+      CGContextSaveGState(_cg_ctx);
+      CGContextClipToRect(_cg_ctx, to_cg_rect(clip_inner_rect(rect)));
     }
-    else {
-      render_styled_path<false>(BLRect(base.x, base.y, wh, wh), style, op);
+    else if (mode == ClipMode::kPerCall) {
+      CGContextSaveGState(_cg_ctx);
+      CGContextClipToRect(_cg_ctx, to_cg_rect(clip_call_rect(rect)));
     }
 
-    CGContextRestoreGState(_cg_ctx);
+    if (style == StyleKind::kSolid)
+      render_solid_rect(rect, RenderOp::kFillNonZero);
+    else
+      render_styled_rect<true>(rect, style, RenderOp::kFillNonZero);
+
+    if (mode == ClipMode::kNested) {
+      CGContextRestoreGState(_cg_ctx);
+      CGContextRestoreGState(_cg_ctx);
+    }
+    else if (mode == ClipMode::kPerCall) {
+      CGContextRestoreGState(_cg_ctx);
+    }
   }
 
-  CGPathRelease(path);
+  if (mode == ClipMode::kStatic)
+    CGContextRestoreGState(_cg_ctx);
+}
+
+void CoreGraphicsModule::render_gradient_stops(uint32_t stop_count, bool reuse) {
+  // Not supported, see supports_test().
+  (void)stop_count;
+  (void)reuse;
 }
 
 Backend* create_cg_backend() {
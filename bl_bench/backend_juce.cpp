@@ -115,6 +115,26 @@ static void convert_juce_image_to_blend2d_image(BLImage& dst, juce::Image& src)
   }
 }
 
+static inline juce::PathStrokeType::JointStyle to_juce_joint_style(StrokeJoin join) noexcept {
+  switch (join) {
+    case StrokeJoin::kRound: return juce::PathStrokeType::curved;
+    case StrokeJoin::kBevel: return juce::PathStrokeType::beveled;
+
+    default:
+      return juce::PathStrokeType::mitered;
+  }
+}
+
+static inline juce::PathStrokeType::EndCapStyle to_juce_end_style(StrokeCap cap) noexcept {
+  switch (cap) {
+    case StrokeCap::kRound : return juce::PathStrokeType::rounded;
+    case StrokeCap::kSquare: return juce::PathStrokeType::square;
+
+    default:
+      return juce::PathStrokeType::butt;
+  }
+}
+
 static inline juce::Colour toJuceColor(BLRgba32 rgba) noexcept {
   return juce::Colour(
     uint8_t(rgba.r()),
@@ -123,6 +143,39 @@ static inline juce::Colour toJuceColor(BLRgba32 rgba) noexcept {
     uint8_t(rgba.a()));
 }
 
+// Adds `shape` scaled by `scale` and translated by `offset` to `path`.
+static void add_shape_path(juce::Path& path, ShapeData shape, double scale, const BLPoint& offset) {
+  double x = offset.x;
+  double y = offset.y;
+
+  ShapeIterator it(shape);
+  while (it.has_command()) {
+    if (it.is_move_to()) {
+      path.startNewSubPath(
+        float(x + it.x(0) * scale), float(y + it.y(0) * scale));
+    }
+    else if (it.is_line_to()) {
+      path.lineTo(
+        float(x + it.x(0) * scale), float(y + it.y(0) * scale));
+    }
+    else if (it.is_quad_to()) {
+      path.quadraticTo(
+        float(x + it.x(0) * scale), float(y + it.y(0) * scale),
+        float(x + it.x(1) * scale), float(y + it.y(1) * scale));
+    }
+    else if (it.is_cubic_to()) {
+      path.cubicTo(
+        float(x + it.x(0) * scale), float(y + it.y(0) * scale),
+        float(x + it.x(1) * scale), float(y + it.y(1) * scale),
+        float(x + it.x(2) * scale), float(y + it.y(2) * scale));
+    }
+    else {
+      path.closeSubPath();
+    }
+    it.next();
+  }
+}
+
 struct JuceModule : public Backend {
   juce::SoftwareImageType _juce_image_type;
   juce::PathStrokeType _juce_stroke_type;
@@ -134,6 +187,11 @@ struct JuceModule : public Backend {
   juce::Image _juce_sprites_opaque[kBenchNumSprites];
   juce::Graphics* _juce_context {};
 
+  // Initialized by before_run() of shape tests - the path to replay (or to rebuild, which keeps its capacity across
+  // render calls) and paths of ShapePathMode::kCached.
+  juce::Path _shape_path;
+  std::vector<juce::Path> _cached_paths;
+
   JuceModule();
   ~JuceModule() override;
 
@@ -141,6 +199,10 @@ struct JuceModule : public Backend {
 
   bool supports_comp_op(BLCompOp comp_op) const override;
   bool supports_style(StyleKind style) const override;
+  bool supports_format(BLFormat format) const override;
+  bool supports_test(TestKind test) const override;
+  bool supports_stroke(StrokeKind stroke) const override;
+  bool supports_shape_path(ShapePathMode shape_path) const override;
 
   void before_run() override;
   void flush() override;
@@ -151,11 +213,17 @@ struct JuceModule : public Backend {
 
   void render_rect_a(RenderOp op) override;
   void render_rect_f(RenderOp op) override;
+  void render_rect_a_batch(RenderOp op) override;
+  void render_rect_f_batch(RenderOp op) override;
   void render_rect_rotated(RenderOp op) override;
   void render_round_f(RenderOp op) override;
   void render_round_rotated(RenderOp op) override;
-  void render_polygon(RenderOp op, uint32_t complexity) override;
+  void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) override;
   void render_shape(RenderOp op, ShapeData shape) override;
+  void render_text(TextKind kind) override;
+  void render_blit_scaled(BLSizeI dst_size, bool fractional) override;
+  void render_rect_clip(ClipMode mode) override;
+  void render_gradient_stops(uint32_t stop_count, bool reuse) override;
 };
 
 JuceModule::JuceModule()
@@ -190,17 +258,51 @@ bool JuceModule::supports_style(StyleKind style) const {
          style == StyleKind::kPatternBI ;
 }
 
+bool JuceModule::supports_format(BLFormat format) const {
+  return to_juce_format(format) != juce::Image::UnknownFormat;
+}
+
+bool JuceModule::supports_test(TestKind test) const {
+  // Text and gradients of many stops are not implemented by this backend.
+  return !is_text_test(test) && !is_gradient_stop_test(test);
+}
+
+bool JuceModule::supports_stroke(StrokeKind stroke) const {
+  // Dashes are only provided by `PathStrokeType::createDashedStroke()`, which is not a stroke option.
+  return !stroke_options_of(stroke).is_dashed();
+}
+
+bool JuceModule::supports_shape_path(ShapePathMode shape_path) const {
+  return true;
+}
+
 void JuceModule::before_run() {
   int w = int(_params.screen_w);
   int h = int(_params.screen_h);
   StyleKind style = _params.style;
 
   _opaque_bits = _params.comp_op == BL_COMP_OP_SRC_COPY ? 0xFF000000u : 0x00000000u;
-  _line_thickness = float(_params.stroke_width);
-  _juce_stroke_type.setEndStyle(juce::PathStrokeType::butt);
-  _juce_stroke_type.setJointStyle(juce::PathStrokeType::mitered);
+
+  const StrokeOptions& stroke = stroke_options_of(_params.stroke);
+  _line_thickness = float(stroke.width);
+  _juce_stroke_type.setEndStyle(to_juce_end_style(stroke.cap));
+  _juce_stroke_type.setJointStyle(to_juce_joint_style(stroke.join));
   _juce_stroke_type.setStrokeThickness(_line_thickness);
 
+  bool shape_non_zero = shape_render_op_of(_params.testKind) != RenderOp::kFillEvenOdd;
+
+  _shape_path.clear();
+  if (needs_replay_path())
+    add_shape_path(_shape_path, _cached_shape, double(_params.shape_size), BLPoint(0, 0));
+  _shape_path.setUsingNonZeroWinding(shape_non_zero);
+
+  _cached_paths.resize(_cached_shape_origins.size());
+  for (size_t i = 0; i < _cached_paths.size(); i++) {
+    _cached_paths[i].clear();
+    add_shape_path(_cached_paths[i], _cached_shape, double(_params.shape_size), _cached_shape_origins[i]);
+    _cached_paths[i].setUsingNonZeroWinding(shape_non_zero);
+  }
+
   for (uint32_t i = 0; i < kBenchNumSprites; i++) {
     BLImage opaque(_sprites[i]);
     opaque.convert(BL_FORMAT_XRGB32);
@@ -242,9 +344,9 @@ inline void JuceModule::setup_style(const RectT& rect, StyleKind style) {
     case StyleKind::kLinearPad:
     case StyleKind::kLinearRepeat:
     case StyleKind::kLinearReflect: {
-      BLRgba32 c0 = _rnd_color.next_rgba32(_opaque_bits);
-      BLRgba32 c1 = _rnd_color.next_rgba32(_opaque_bits);
-      BLRgba32 c2 = _rnd_color.next_rgba32(_opaque_bits);
+      BLRgba32 c0 = next_color(_opaque_bits);
+      BLRgba32 c1 = next_color(_opaque_bits);
+      BLRgba32 c2 = next_color(_opaque_bits);
 
       float x0 = float(rect.x) + rect.w * float(0.2);
       float y0 = float(rect.y) + rect.h * float(0.2);
@@ -260,9 +362,9 @@ inline void JuceModule::setup_style(const RectT& rect, StyleKind style) {
     case StyleKind::kRadialPad:
     case StyleKind::kRadialRepeat:
     case StyleKind::kRadialReflect: {
-      BLRgba32 c0 = _rnd_color.next_rgba32(_opaque_bits);
-      BLRgba32 c1 = _rnd_color.next_rgba32(_opaque_bits);
-      BLRgba32 c2 = _rnd_color.next_rgba32(_opaque_bits);
+      BLRgba32 c0 = next_color(_opaque_bits);
+      BLRgba32 c1 = next_color(_opaque_bits);
+      BLRgba32 c2 = next_color(_opaque_bits);
 
       float cx = float(rect.x + rect.w / 2);
       float cy = float(rect.y + rect.h / 2);
@@ -298,8 +400,8 @@ void JuceModule::render_rect_a(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI r = _rnd_coord.next_rect_i(bounds, wh, wh);
-      _juce_context->setColour(toJuceColor(_rnd_color.next_rgba32(_opaque_bits)));
+      BLRectI r = next_rect_i(bounds, wh, wh);
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
 
       if (op == RenderOp::kStroke)
         _juce_context->drawRect(juce::Rectangle<int>(r.x, r.y, r.w, r.h), _line_thickness);
@@ -310,20 +412,20 @@ void JuceModule::render_rect_a(RenderOp op) {
   else if ((style == StyleKind::kPatternNN || style == StyleKind::kPatternBI) && op != RenderOp::kStroke) {
     if (_params.comp_op == BL_COMP_OP_SRC_OVER) {
       for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-        BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
+        BLRectI rect(next_rect_i(bounds, wh, wh));
         _juce_context->drawImageAt(_juce_sprites[nextSpriteId()], rect.x, rect.y);
       }
     }
     else {
       for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-        BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
+        BLRectI rect(next_rect_i(bounds, wh, wh));
         _juce_context->drawImageAt(_juce_sprites_opaque[nextSpriteId()], rect.x, rect.y);
       }
     }
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI r = _rnd_coord.next_rect_i(bounds, wh, wh);
+      BLRectI r = next_rect_i(bounds, wh, wh);
       setup_style(r, style);
 
       if (op == RenderOp::kStroke)
@@ -341,8 +443,8 @@ void JuceModule::render_rect_f(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect r = _rnd_coord.next_rect(bounds, wh, wh);
-      _juce_context->setColour(toJuceColor(_rnd_color.next_rgba32(_opaque_bits)));
+      BLRect r = next_rect(bounds, wh, wh);
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
 
       if (op == RenderOp::kStroke)
         _juce_context->drawRect(juce::Rectangle<float>(float(r.x), float(r.y), float(r.w), float(r.h)), _line_thickness);
@@ -352,7 +454,7 @@ void JuceModule::render_rect_f(RenderOp op) {
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect r = _rnd_coord.next_rect(bounds, wh, wh);
+      BLRect r = next_rect(bounds, wh, wh);
       setup_style(r, style);
 
       if (op == RenderOp::kStroke)
@@ -363,6 +465,75 @@ void JuceModule::render_rect_f(RenderOp op) {
   }
 }
 
+void JuceModule::render_rect_a_batch(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  int wh = _params.shape_size;
+
+  juce::RectangleList<int> rects;
+  juce::Path path;
+
+  // JUCE can only fill a rectangle list, strokes are rendered as a single path.
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    rects.clear();
+    path.clear();
+
+    for (uint32_t j = 0; j < n; j++) {
+      BLRectI r = next_rect_i(bounds, wh, wh);
+      if (op == RenderOp::kStroke)
+        path.addRectangle(float(r.x), float(r.y), float(r.w), float(r.h));
+      else
+        rects.addWithoutMerging(juce::Rectangle<int>(r.x, r.y, r.w, r.h));
+    }
+
+    if (style == StyleKind::kSolid)
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
+    else
+      setup_style(BLRectI(0, 0, bounds.w, bounds.h), style);
+
+    if (op == RenderOp::kStroke)
+      _juce_context->strokePath(path, _juce_stroke_type);
+    else
+      _juce_context->fillRectList(rects);
+  }
+}
+
+void JuceModule::render_rect_f_batch(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  juce::RectangleList<float> rects;
+  juce::Path path;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    rects.clear();
+    path.clear();
+
+    for (uint32_t j = 0; j < n; j++) {
+      BLRect r = next_rect(bounds, wh, wh);
+      if (op == RenderOp::kStroke)
+        path.addRectangle(float(r.x), float(r.y), float(r.w), float(r.h));
+      else
+        rects.addWithoutMerging(juce::Rectangle<float>(float(r.x), float(r.y), float(r.w), float(r.h)));
+    }
+
+    if (style == StyleKind::kSolid)
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
+    else
+      setup_style(BLRect(0, 0, bounds.w, bounds.h), style);
+
+    if (op == RenderOp::kStroke)
+      _juce_context->strokePath(path, _juce_stroke_type);
+    else
+      _juce_context->fillRectList(rects);
+  }
+}
+
 void JuceModule::render_rect_rotated(RenderOp op) {
   BLSize bounds(_params.screen_w, _params.screen_h);
   StyleKind style = _params.style;
@@ -370,17 +541,17 @@ void JuceModule::render_rect_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect r(_rnd_coord.next_rect(bounds, wh, wh));
+    BLRect r(next_rect(bounds, wh, wh));
     juce::AffineTransform tr = juce::AffineTransform::rotation(float(angle), float(cx), float(cy));
 
     _juce_context->saveState();
     _juce_context->addTransform(tr);
 
     if (style == StyleKind::kSolid) {
-      _juce_context->setColour(toJuceColor(_rnd_color.next_rgba32(_opaque_bits)));
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
     }
     else {
       setup_style(r, style);
@@ -393,6 +564,8 @@ void JuceModule::render_rect_rotated(RenderOp op) {
 
     _juce_context->restoreState();
   }
+
+  _rotation_angle = angle;
 }
 
 void JuceModule::render_round_f(RenderOp op) {
@@ -401,11 +574,11 @@ void JuceModule::render_round_f(RenderOp op) {
   double wh = _params.shape_size;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRect r(_rnd_coord.next_rect(bounds, wh, wh));
-    float radius = float(_rnd_extra.next_double(4.0, 40.0));
+    BLRect r(next_rect(bounds, wh, wh));
+    float radius = float(next_radius());
 
     if (style == StyleKind::kSolid) {
-      _juce_context->setColour(toJuceColor(_rnd_color.next_rgba32(_opaque_bits)));
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
     }
     else {
       setup_style(r, style);
@@ -425,18 +598,18 @@ void JuceModule::render_round_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect r(_rnd_coord.next_rect(bounds, wh, wh));
-    float radius = float(_rnd_extra.next_double(4.0, 40.0));
+    BLRect r(next_rect(bounds, wh, wh));
+    float radius = float(next_radius());
     juce::AffineTransform tr = juce::AffineTransform::rotation(float(angle), float(cx), float(cy));
 
     _juce_context->saveState();
     _juce_context->addTransform(tr);
 
     if (style == StyleKind::kSolid) {
-      _juce_context->setColour(toJuceColor(_rnd_color.next_rgba32(_opaque_bits)));
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
     }
     else {
       setup_style(r, style);
@@ -449,9 +622,11 @@ void JuceModule::render_round_rotated(RenderOp op) {
 
     _juce_context->restoreState();
   }
+
+  _rotation_angle = angle;
 }
 
-void JuceModule::render_polygon(RenderOp op, uint32_t complexity) {
+void JuceModule::render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
@@ -461,27 +636,25 @@ void JuceModule::render_polygon(RenderOp op, uint32_t complexity) {
   path.setUsingNonZeroWinding(op != RenderOp::kFillEvenOdd);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base(next_origin(bounds));
 
-    double x = _rnd_coord.next_double(base.x, base.x + wh);
-    double y = _rnd_coord.next_double(base.y, base.y + wh);
+    BLPoint v = next_vertex(kind, base, wh, 0);
 
     path.clear();
-    path.startNewSubPath(float(x), float(y));
+    path.startNewSubPath(float(v.x), float(v.y));
 
     for (uint32_t p = 1; p < complexity; p++) {
-      x = _rnd_coord.next_double(base.x, base.x + wh);
-      y = _rnd_coord.next_double(base.y, base.y + wh);
-      path.lineTo(float(x), float(y));
+      v = next_vertex(kind, base, wh, p);
+      path.lineTo(float(v.x), float(v.y));
     }
 
     path.closeSubPath();
 
     if (style == StyleKind::kSolid) {
-      _juce_context->setColour(toJuceColor(_rnd_color.next_rgba32(_opaque_bits)));
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
     }
     else {
-      setup_style(BLRect(x, y, wh, wh), style);
+      setup_style(BLRect(v.x, v.y, wh, wh), style);
     }
 
     if (op == RenderOp::kStroke)
@@ -495,54 +668,124 @@ void JuceModule::render_shape(RenderOp op, ShapeData shape) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
+  ShapePathMode shape_path = _params.shape_path;
   double wh = double(_params.shape_size);
+  bool non_zero = op != RenderOp::kFillEvenOdd;
 
-  juce::Path path;
-  path.setUsingNonZeroWinding(op != RenderOp::kFillEvenOdd);
+  // The winding rule of the replayed and cached paths is set by before_run().
+  juce::Path& path = _shape_path;
 
-  ShapeIterator it(shape);
-  while (it.has_command()) {
-    if (it.is_move_to()) {
-      path.startNewSubPath(
-        float(it.x(0) * wh), float(it.y(0) * wh));
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base;
+    juce::AffineTransform transform;
+    const juce::Path* juce_path = &path;
+
+    if (shape_path == ShapePathMode::kCached) {
+      uint32_t index = next_cached_shape();
+      base = _cached_shape_origins[index];
+      juce_path = &_cached_paths[index];
     }
-    else if (it.is_line_to()) {
-      path.lineTo(
-        float(it.x(0) * wh), float(it.y(0) * wh));
+    else if (shape_path == ShapePathMode::kRebuild) {
+      base = next_origin(bounds);
+
+      path.clear();
+      add_shape_path(path, shape, wh, base);
+      path.setUsingNonZeroWinding(non_zero);
     }
-    else if (it.is_quad_to()) {
-      path.quadraticTo(
-        float(it.x(0) * wh), float(it.y(0) * wh),
-        float(it.x(1) * wh), float(it.y(1) * wh));
+    else {
+      base = next_origin(bounds);
+      transform = juce::AffineTransform::translation(float(base.x), float(base.y));
     }
-    else if (it.is_cubic_to()) {
-      path.cubicTo(
-        float(it.x(0) * wh), float(it.y(0) * wh),
-        float(it.x(1) * wh), float(it.y(1) * wh),
-        float(it.x(2) * wh), float(it.y(2) * wh));
+
+    if (style == StyleKind::kSolid) {
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
     }
     else {
-      path.closeSubPath();
+      setup_style(BLRect(base.x, base.y, wh, wh), style);
     }
-    it.next();
+
+    if (op == RenderOp::kStroke)
+      _juce_context->strokePath(*juce_path, _juce_stroke_type, transform);
+    else
+      _juce_context->fillPath(*juce_path, transform);
   }
+}
+
+void JuceModule::render_text(TextKind kind) {
+  // Not supported, see supports_test().
+  (void)kind;
+}
+
+void JuceModule::render_blit_scaled(BLSizeI dst_size, bool fractional) {
+  const juce::Image* sprites = _params.comp_op == BL_COMP_OP_SRC_OVER ? _juce_sprites : _juce_sprites_opaque;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
-    juce::AffineTransform transform = juce::AffineTransform::translation(float(base.x), float(base.y));
+    BLRect rect(next_blit_rect(dst_size, fractional));
+    const juce::Image& sprite = sprites[nextSpriteId()];
 
-    if (style == StyleKind::kSolid) {
-      _juce_context->setColour(toJuceColor(_rnd_color.next_rgba32(_opaque_bits)));
+    juce::AffineTransform transform = juce::AffineTransform::scale(
+      float(rect.w / double(sprite.getWidth())),
+      float(rect.h / double(sprite.getHeight()))).translated(float(rect.x), float(rect.y));
+
+    _juce_context->drawImageTransformed(sprite, transform);
+  }
+}
+
+void JuceModule::render_rect_clip(ClipMode mode) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  // JUCE only clips to integral rectangles, thus fractional clip rectangles are rounded.
+  auto to_juce_clip = [](const BLRect& r) {
+    return juce::Rectangle<float>(float(r.x), float(r.y), float(r.w), float(r.h)).toNearestInt();
+  };
+
+  if (mode == ClipMode::kStatic) {
+    BLRectI clip = static_clip_rect();
+
+    _juce_context->saveState();
+    _juce_context->reduceClipRegion(juce::Rectangle<int>(clip.x, clip.y, clip.w, clip.h));
+  }
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect r = next_rect(bounds, wh, wh);
+
+    // JUCE has no way to replace the clip, thus a clip that changes per call needs its own save/restore scope.
+    if (mode == ClipMode::kNested) {
+      _juce_context->saveState();
+      _juce_context->reduceClipRegion(to_juce_clip(clip_outer_rect(r)));
+      _juce_context->saveState();
+      _juce_context->reduceClipRegion(to_juce_clip(clip_inner_rect(r)));
     }
-    else {
-      setup_style(BLRect(base.x, base.y, wh, wh), style);
+    else if (mode == ClipMode::kPerCall) {
+      _juce_context->saveState();
+      _juce_context->reduceClipRegion(to_juce_clip(clip_call_rect(r)));
     }
 
-    if (op == RenderOp::kStroke)
-      _juce_context->strokePath(path, _juce_stroke_type, transform);
+    if (style == StyleKind::kSolid)
+      _juce_context->setColour(toJuceColor(next_color(_opaque_bits)));
     else
-      _juce_context->fillPath(path, transform);
+      setup_style(r, style);
+    _juce_context->fillRect(juce::Rectangle<float>(float(r.x), float(r.y), float(r.w), float(r.h)));
+
+    if (mode == ClipMode::kNested) {
+      _juce_context->restoreState();
+      _juce_context->restoreState();
+    }
+    else if (mode == ClipMode::kPerCall) {
+      _juce_context->restoreState();
+    }
   }
+
+  if (mode == ClipMode::kStatic)
+    _juce_context->restoreState();
+}
+
+void JuceModule::render_gradient_stops(uint32_t stop_count, bool reuse) {
+  // Not supported, see supports_test().
+  (void)stop_count;
+  (void)reuse;
 }
 
 Backend* create_juce_backend() {
@@ -0,0 +1,297 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "app.h"
+#include "backend_null.h"
+
+#include <string.h>
+
+namespace blbench {
+
+// Null backend consumes the same inputs as rendering backends (coordinates, colors, radii, sprites), but renders
+// nothing. Its results are the cost of the benchmarking harness itself, which is not negligible at small sizes.
+struct NullModule : public Backend {
+  //! Accumulates all consumed inputs so the compiler cannot remove the loops.
+  double _sink {};
+
+  NullModule();
+  ~NullModule() override;
+
+  bool supports_comp_op(BLCompOp comp_op) const override;
+  bool supports_style(StyleKind style) const override;
+  bool supports_format(BLFormat format) const override;
+  bool supports_test(TestKind test) const override;
+  bool supports_stroke(StrokeKind stroke) const override;
+  bool supports_shape_path(ShapePathMode shape_path) const override;
+
+  void before_run() override;
+  void flush() override;
+  void after_run() override;
+
+  template<typename RectT>
+  inline void consume_style(const RectT& rect, StyleKind style);
+
+  void render_rect_a(RenderOp op) override;
+  void render_rect_f(RenderOp op) override;
+  void render_rect_a_batch(RenderOp op) override;
+  void render_rect_f_batch(RenderOp op) override;
+  void render_rect_rotated(RenderOp op) override;
+  void render_round_f(RenderOp op) override;
+  void render_round_rotated(RenderOp op) override;
+  void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) override;
+  void render_shape(RenderOp op, ShapeData shape) override;
+  void render_text(TextKind kind) override;
+  void render_blit_scaled(BLSizeI dst_size, bool fractional) override;
+  void render_rect_clip(ClipMode mode) override;
+  void render_gradient_stops(uint32_t stop_count, bool reuse) override;
+};
+
+NullModule::NullModule() {
+  strcpy(_name, "Null");
+}
+NullModule::~NullModule() {}
+
+template<typename RectT>
+inline void NullModule::consume_style(const RectT& rect, StyleKind style) {
+  _sink += double(rect.x) + double(rect.y);
+
+  if (style == StyleKind::kSolid) {
+    _sink += double(next_color().value);
+  }
+  else if (style <= StyleKind::kConic) {
+    _sink += double(next_color().value);
+    _sink += double(next_color().value);
+    _sink += double(next_color().value);
+  }
+  else {
+    _sink += double(_sprites[nextSpriteId()].width());
+  }
+}
+
+bool NullModule::supports_comp_op(BLCompOp comp_op) const {
+  return true;
+}
+
+bool NullModule::supports_style(StyleKind style) const {
+  return true;
+}
+
+bool NullModule::supports_format(BLFormat format) const {
+  return format == BL_FORMAT_PRGB32 ||
+         format == BL_FORMAT_XRGB32 ||
+         format == BL_FORMAT_A8     ;
+}
+
+bool NullModule::supports_test(TestKind test) const {
+  return true;
+}
+
+bool NullModule::supports_stroke(StrokeKind stroke) const {
+  return true;
+}
+
+bool NullModule::supports_shape_path(ShapePathMode shape_path) const {
+  return true;
+}
+
+void NullModule::before_run() {
+  // The surface is only created so the result can be saved the same way as results of other backends.
+  _surface.create(int(_params.screen_w), int(_params.screen_h), _params.format);
+  _sink = 0.0;
+}
+
+void NullModule::flush() {
+  // Nothing...
+}
+
+void NullModule::after_run() {
+  // Only makes the sink observable.
+  volatile double sink = _sink;
+  (void)sink;
+}
+
+void NullModule::render_rect_a(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  int wh = _params.shape_size;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRectI rect(next_rect_i(bounds, wh, wh));
+    consume_style(rect, style);
+  }
+}
+
+void NullModule::render_rect_f(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_rect(bounds, wh, wh));
+    consume_style(rect, style);
+  }
+}
+
+void NullModule::render_rect_a_batch(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  int wh = _params.shape_size;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+    for (uint32_t j = 0; j < n; j++) {
+      BLRectI rect(next_rect_i(bounds, wh, wh));
+      _sink += double(rect.x) + double(rect.y);
+    }
+    consume_style(BLRectI(0, 0, bounds.w, bounds.h), style);
+  }
+}
+
+void NullModule::render_rect_f_batch(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+    for (uint32_t j = 0; j < n; j++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+      _sink += rect.x + rect.y;
+    }
+    consume_style(BLRect(0, 0, bounds.w, bounds.h), style);
+  }
+}
+
+void NullModule::render_rect_rotated(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+  double angle = _rotation_angle;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
+    BLRect rect(next_rect(bounds, wh, wh));
+    consume_style(rect, style);
+    _sink += angle;
+  }
+
+  _rotation_angle = angle;
+}
+
+void NullModule::render_round_f(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    double radius = next_radius();
+    BLRect rect(next_rect(bounds, wh, wh));
+    consume_style(rect, style);
+    _sink += radius;
+  }
+}
+
+void NullModule::render_round_rotated(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+  double angle = _rotation_angle;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
+    double radius = next_radius();
+    BLRect rect(next_rect(bounds, wh, wh));
+    consume_style(rect, style);
+    _sink += radius + angle;
+  }
+
+  _rotation_angle = angle;
+}
+
+void NullModule::render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) {
+  BLSizeI bounds(_params.screen_w - _params.shape_size, _params.screen_h - _params.shape_size);
+  StyleKind style = _params.style;
+  double wh = double(_params.shape_size);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base(next_origin(bounds));
+
+    for (uint32_t p = 0; p < complexity; p++) {
+      BLPoint v = next_vertex(kind, base, wh, p);
+      _sink += v.x + v.y;
+    }
+
+    consume_style(BLRect(base.x, base.y, wh, wh), style);
+  }
+}
+
+void NullModule::render_shape(RenderOp op, ShapeData shape) {
+  BLSizeI bounds(_params.screen_w - _params.shape_size, _params.screen_h - _params.shape_size);
+  StyleKind style = _params.style;
+  double wh = double(_params.shape_size);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base;
+    if (_params.shape_path == ShapePathMode::kCached)
+      base = _cached_shape_origins[next_cached_shape()];
+    else
+      base = next_origin(bounds);
+
+    consume_style(BLRect(base.x, base.y, wh, wh), style);
+  }
+}
+
+void NullModule::render_text(TextKind kind) {
+  BLSizeI bounds(_params.screen_w - _params.shape_size,
+                 _params.screen_h - _params.shape_size);
+  StyleKind style = _params.style;
+  double wh = double(_params.shape_size);
+
+  TextData text;
+  get_text_data(text, kind);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base(next_origin(bounds));
+    consume_style(BLRect(base.x, base.y, wh, wh), style);
+    _sink += double(text.glyph_count);
+  }
+}
+
+void NullModule::render_blit_scaled(BLSizeI dst_size, bool fractional) {
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_blit_rect(dst_size, fractional));
+    _sink += rect.x + rect.y + double(_sprites[nextSpriteId()].width());
+  }
+}
+
+void NullModule::render_rect_clip(ClipMode mode) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_rect(bounds, wh, wh));
+    BLRect clip(mode == ClipMode::kNested ? clip_inner_rect(rect) : clip_call_rect(rect));
+
+    _sink += clip.x + clip.y;
+    consume_style(rect, style);
+  }
+}
+
+void NullModule::render_gradient_stops(uint32_t stop_count, bool reuse) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  double wh = _params.shape_size;
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_rect(bounds, wh, wh));
+    BLRgba32 first_color = reuse ? _gradient_colors[0] : next_color();
+
+    _sink += rect.x + rect.y + double(first_color.value) + double(stop_count);
+  }
+}
+
+Backend* create_null_backend() {
+  return new NullModule();
+}
+
+} // {blbench}
@@ -0,0 +1,17 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_BACKEND_NULL_H
+#define BLBENCH_BACKEND_NULL_H
+
+#include "backend.h"
+
+namespace blbench {
+
+Backend* create_null_backend();
+
+} // {blbench}
+
+#endif // BLBENCH_BACKEND_NULL_H
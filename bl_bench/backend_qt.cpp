@@ -21,6 +21,7 @@ static uint32_t to_qt_format(BLFormat format) {
   switch (format) {
     case BL_FORMAT_PRGB32: return QImage::Format_ARGB32_Premultiplied;
     case BL_FORMAT_XRGB32: return QImage::Format_RGB32;
+    case BL_FORMAT_A8    : return QImage::Format_Alpha8;
 
     default:
       return 0xFFFFFFFFu;
@@ -59,6 +60,80 @@ static uint32_t to_qt_operator(BLCompOp comp_op) {
   }
 }
 
+// Qt's miter limit is measured from the join point in units of the pen width, thus it's half of the SVG one. The dash
+// pattern is in units of the pen width as well. The brush is set by each render call.
+static QPen to_qt_pen(const StrokeOptions& stroke) {
+  QPen pen(QBrush(Qt::black), stroke.hairline ? qreal(0) : qreal(stroke.width));
+
+  switch (stroke.join) {
+    case StrokeJoin::kMiter: pen.setJoinStyle(Qt::MiterJoin); break;
+    case StrokeJoin::kRound: pen.setJoinStyle(Qt::RoundJoin); break;
+    case StrokeJoin::kBevel: pen.setJoinStyle(Qt::BevelJoin); break;
+  }
+
+  switch (stroke.cap) {
+    case StrokeCap::kButt  : pen.setCapStyle(Qt::FlatCap); break;
+    case StrokeCap::kRound : pen.setCapStyle(Qt::RoundCap); break;
+    case StrokeCap::kSquare: pen.setCapStyle(Qt::SquareCap); break;
+  }
+
+  pen.setMiterLimit(qreal(kBenchMiterLimit * 0.5));
+
+  if (stroke.is_dashed()) {
+    QVector<qreal> dashes;
+    dashes << qreal(stroke.dash_on / stroke.width) << qreal(stroke.dash_off / stroke.width);
+    pen.setDashPattern(dashes);
+  }
+
+  return pen;
+}
+
+// Fonts require a QGuiApplication, which is created by the first text test (and never destroyed). The offscreen
+// platform is used unless `QT_QPA_PLATFORM` is set, so the benchmark doesn't require a display.
+static void ensure_qt_gui_application() {
+  if (QCoreApplication::instance())
+    return;
+
+  if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  static int argc = 1;
+  static char arg0[] = "bl_bench";
+  static char* argv[] = { arg0, nullptr };
+  new QGuiApplication(argc, argv);
+}
+
+// Adds `shape` scaled by `scale` and translated by `offset` to `path`.
+static void add_shape_path(QPainterPath& path, ShapeData shape, double scale, const BLPoint& offset) {
+  double x = offset.x;
+  double y = offset.y;
+
+  ShapeIterator it(shape);
+  while (it.has_command()) {
+    if (it.is_move_to()) {
+      path.moveTo(x + it.x(0) * scale, y + it.y(0) * scale);
+    }
+    else if (it.is_line_to()) {
+      path.lineTo(x + it.x(0) * scale, y + it.y(0) * scale);
+    }
+    else if (it.is_quad_to()) {
+      path.quadTo(
+        x + it.x(0) * scale, y + it.y(0) * scale,
+        x + it.x(1) * scale, y + it.y(1) * scale);
+    }
+    else if (it.is_cubic_to()) {
+      path.cubicTo(
+        x + it.x(0) * scale, y + it.y(0) * scale,
+        x + it.x(1) * scale, y + it.y(1) * scale,
+        x + it.x(2) * scale, y + it.y(2) * scale);
+    }
+    else {
+      path.closeSubpath();
+    }
+    it.next();
+  }
+}
+
 struct QtModule : public Backend {
   QImage* _qt_surface {};
   QImage* _qt_sprites[kBenchNumSprites] {};
@@ -67,6 +142,16 @@ struct QtModule : public Backend {
   // Initialized by before_run().
   uint32_t _gradient_spread {};
 
+  // Initialized by before_run() of shape tests - the path to replay (or to rebuild, which keeps its capacity across
+  // render calls) and paths of ShapePathMode::kCached.
+  QPainterPath _shape_path;
+  std::vector<QPainterPath> _cached_paths;
+
+  // Initialized by before_run() of text tests.
+  QString _qt_font_family;
+  QFont _qt_font;
+  QGlyphRun _qt_glyph_run;
+
   QtModule();
   ~QtModule() override;
 
@@ -75,8 +160,15 @@ struct QtModule : public Backend {
   template<typename RectT>
   inline QBrush create_brush(StyleKind style, const RectT& rect);
 
+  inline void add_gradient_stops(QGradient& g, uint32_t stop_count, BLRgba32 first_color);
+  QBrush create_gradient_brush(StyleKind style, const BLRect& rect, uint32_t stop_count, BLRgba32 first_color);
+
   bool supports_comp_op(BLCompOp comp_op) const override;
   bool supports_style(StyleKind style) const override;
+  bool supports_format(BLFormat format) const override;
+  bool supports_test(TestKind test) const override;
+  bool supports_stroke(StrokeKind stroke) const override;
+  bool supports_shape_path(ShapePathMode shape_path) const override;
 
   void before_run() override;
   void flush() override;
@@ -84,11 +176,17 @@ struct QtModule : public Backend {
 
   void render_rect_a(RenderOp op) override;
   void render_rect_f(RenderOp op) override;
+  void render_rect_a_batch(RenderOp op) override;
+  void render_rect_f_batch(RenderOp op) override;
   void render_rect_rotated(RenderOp op) override;
   void render_round_f(RenderOp op) override;
   void render_round_rotated(RenderOp op) override;
-  void render_polygon(RenderOp op, uint32_t complexity) override;
+  void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) override;
   void render_shape(RenderOp op, ShapeData shape) override;
+  void render_text(TextKind kind) override;
+  void render_blit_scaled(BLSizeI dst_size, bool fractional) override;
+  void render_rect_clip(ClipMode mode) override;
+  void render_gradient_stops(uint32_t stop_count, bool reuse) override;
 };
 
 QtModule::QtModule() {
@@ -114,9 +212,9 @@ inline QBrush QtModule::create_brush(StyleKind style, const RectT& rect) {
       double y1 = rect.y + rect.h * 0.8;
 
       QLinearGradient g((qreal)x0, (qreal)y0, (qreal)x1, (qreal)y1);
-      g.setColorAt(qreal(0.0), to_qt_color(_rnd_color.next_rgba32()));
-      g.setColorAt(qreal(0.5), to_qt_color(_rnd_color.next_rgba32()));
-      g.setColorAt(qreal(1.0), to_qt_color(_rnd_color.next_rgba32()));
+      g.setColorAt(qreal(0.0), to_qt_color(next_color()));
+      g.setColorAt(qreal(0.5), to_qt_color(next_color()));
+      g.setColorAt(qreal(1.0), to_qt_color(next_color()));
       g.setSpread(static_cast<QGradient::Spread>(_gradient_spread));
       return QBrush(g);
     }
@@ -131,9 +229,9 @@ inline QBrush QtModule::create_brush(StyleKind style, const RectT& rect) {
       double fy = cy - cr / 2;
 
       QRadialGradient g(qreal(cx), qreal(cy), qreal(cr), qreal(fx), qreal(fy), qreal(0));
-      g.setColorAt(qreal(0.0), to_qt_color(_rnd_color.next_rgba32()));
-      g.setColorAt(qreal(0.5), to_qt_color(_rnd_color.next_rgba32()));
-      g.setColorAt(qreal(1.0), to_qt_color(_rnd_color.next_rgba32()));
+      g.setColorAt(qreal(0.0), to_qt_color(next_color()));
+      g.setColorAt(qreal(0.5), to_qt_color(next_color()));
+      g.setColorAt(qreal(1.0), to_qt_color(next_color()));
       g.setSpread(static_cast<QGradient::Spread>(_gradient_spread));
       return QBrush(g);
     }
@@ -141,12 +239,12 @@ inline QBrush QtModule::create_brush(StyleKind style, const RectT& rect) {
     case StyleKind::kConic: {
       double cx = rect.x + rect.w / 2;
       double cy = rect.y + rect.h / 2;
-      QColor c(to_qt_color(_rnd_color.next_rgba32()));
+      QColor c(to_qt_color(next_color()));
 
       QConicalGradient g(qreal(cx), qreal(cy), qreal(0));
       g.setColorAt(qreal(0.00), c);
-      g.setColorAt(qreal(0.33), to_qt_color(_rnd_color.next_rgba32()));
-      g.setColorAt(qreal(0.66), to_qt_color(_rnd_color.next_rgba32()));
+      g.setColorAt(qreal(0.33), to_qt_color(next_color()));
+      g.setColorAt(qreal(0.66), to_qt_color(next_color()));
       g.setColorAt(qreal(1.00), c);
       return QBrush(g);
     }
@@ -168,6 +266,57 @@ inline QBrush QtModule::create_brush(StyleKind style, const RectT& rect) {
   }
 }
 
+// Adds `stop_count` stops of `_gradient_colors` to `g` except the first stop, which uses `first_color`.
+inline void QtModule::add_gradient_stops(QGradient& g, uint32_t stop_count, BLRgba32 first_color) {
+  g.setColorAt(qreal(0.0), to_qt_color(first_color));
+  for (uint32_t i = 1; i < stop_count; i++)
+    g.setColorAt(qreal(gradient_stop_offset(i, stop_count)), to_qt_color(_gradient_colors[i]));
+}
+
+// Creates a gradient brush of `style` spanning `rect`, see `add_gradient_stops()`. The geometry is the same as used
+// by `create_brush()`.
+QBrush QtModule::create_gradient_brush(StyleKind style, const BLRect& rect, uint32_t stop_count, BLRgba32 first_color) {
+  switch (style) {
+    case StyleKind::kLinearPad:
+    case StyleKind::kLinearRepeat:
+    case StyleKind::kLinearReflect: {
+      double x0 = rect.x + rect.w * 0.2;
+      double y0 = rect.y + rect.h * 0.2;
+      double x1 = rect.x + rect.w * 0.8;
+      double y1 = rect.y + rect.h * 0.8;
+
+      QLinearGradient g((qreal)x0, (qreal)y0, (qreal)x1, (qreal)y1);
+      add_gradient_stops(g, stop_count, first_color);
+      g.setSpread(static_cast<QGradient::Spread>(_gradient_spread));
+      return QBrush(g);
+    }
+
+    case StyleKind::kRadialPad:
+    case StyleKind::kRadialRepeat:
+    case StyleKind::kRadialReflect: {
+      double cx = rect.x + rect.w / 2;
+      double cy = rect.y + rect.h / 2;
+      double cr = (rect.w + rect.h) / 4;
+      double fx = cx - cr / 2;
+      double fy = cy - cr / 2;
+
+      QRadialGradient g(qreal(cx), qreal(cy), qreal(cr), qreal(fx), qreal(fy), qreal(0));
+      add_gradient_stops(g, stop_count, first_color);
+      g.setSpread(static_cast<QGradient::Spread>(_gradient_spread));
+      return QBrush(g);
+    }
+
+    default: {
+      double cx = rect.x + rect.w / 2;
+      double cy = rect.y + rect.h / 2;
+
+      QConicalGradient g(qreal(cx), qreal(cy), qreal(0));
+      add_gradient_stops(g, stop_count, first_color);
+      return QBrush(g);
+    }
+  }
+}
+
 bool QtModule::supports_comp_op(BLCompOp comp_op) const {
   return to_qt_operator(comp_op) != 0xFFFFFFFFu;
 }
@@ -185,6 +334,22 @@ bool QtModule::supports_style(StyleKind style) const {
          style == StyleKind::kPatternBI     ;
 }
 
+bool QtModule::supports_format(BLFormat format) const {
+  return to_qt_format(format) != 0xFFFFFFFFu;
+}
+
+bool QtModule::supports_test(TestKind test) const {
+  return true;
+}
+
+bool QtModule::supports_stroke(StrokeKind stroke) const {
+  return true;
+}
+
+bool QtModule::supports_shape_path(ShapePathMode shape_path) const {
+  return true;
+}
+
 void QtModule::before_run() {
   int w = int(_params.screen_w);
   int h = int(_params.screen_h);
@@ -253,6 +418,63 @@ void QtModule::before_run() {
     default:
       break;
   }
+
+  Qt::FillRule shape_fill_rule =
+    shape_render_op_of(_params.testKind) == RenderOp::kFillEvenOdd ? Qt::OddEvenFill : Qt::WindingFill;
+
+  _shape_path.clear();
+  if (needs_replay_path())
+    add_shape_path(_shape_path, _cached_shape, double(_params.shape_size), BLPoint(0, 0));
+  _shape_path.setFillRule(shape_fill_rule);
+
+  _cached_paths.resize(_cached_shape_origins.size());
+  for (size_t i = 0; i < _cached_paths.size(); i++) {
+    _cached_paths[i].clear();
+    add_shape_path(_cached_paths[i], _cached_shape, double(_params.shape_size), _cached_shape_origins[i]);
+    _cached_paths[i].setFillRule(shape_fill_rule);
+  }
+
+  if (is_text_test(_params.testKind)) {
+    if (_qt_font_family.isEmpty()) {
+      ensure_qt_gui_application();
+
+      size_t font_data_size;
+      const uint8_t* font_data = get_text_font_data(&font_data_size);
+
+      int font_id = QFontDatabase::addApplicationFontFromData(
+        QByteArray::fromRawData(reinterpret_cast<const char*>(font_data), qsizetype(font_data_size)));
+
+      QStringList families = QFontDatabase::applicationFontFamilies(font_id);
+      if (!families.isEmpty())
+        _qt_font_family = families.at(0);
+    }
+
+    _qt_font = QFont(_qt_font_family);
+    _qt_font.setPixelSize(int(_params.shape_size));
+    _qt_context->setFont(_qt_font);
+
+    if (_params.testKind == TestKind::kFillGlyphRun) {
+      TextData text;
+      get_text_data(text, TextKind::kGlyphRun);
+
+      QRawFont raw_font = QRawFont::fromFont(_qt_font);
+      QList<quint32> glyph_indexes = raw_font.glyphIndexesForString(QString::fromUtf8(text.lines[0]));
+      QList<QPointF> advances = raw_font.advancesForGlyphIndexes(glyph_indexes);
+
+      // Glyph positions are relative to the origin of the run.
+      QList<QPointF> positions;
+      QPointF position(0, 0);
+
+      for (const QPointF& advance : advances) {
+        positions.append(position);
+        position += advance;
+      }
+
+      _qt_glyph_run.setRawFont(raw_font);
+      _qt_glyph_run.setGlyphIndexes(glyph_indexes);
+      _qt_glyph_run.setPositions(positions);
+    }
+  }
 }
 
 void QtModule::flush() {
@@ -284,8 +506,8 @@ void QtModule::render_rect_a(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
-      QColor color(to_qt_color(_rnd_color.next_rgba32()));
+      BLRectI rect(next_rect_i(bounds, wh, wh));
+      QColor color(to_qt_color(next_color()));
 
       if (op == RenderOp::kStroke) {
         _qt_context->setPen(color);
@@ -299,7 +521,7 @@ void QtModule::render_rect_a(RenderOp op) {
   else {
     if ((style == StyleKind::kPatternNN || style == StyleKind::kPatternBI) && op != RenderOp::kStroke) {
       for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-        BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
+        BLRectI rect(next_rect_i(bounds, wh, wh));
         const QImage& sprite = *_qt_sprites[nextSpriteId()];
 
         _qt_context->drawImage(QPoint(rect.x, rect.y), sprite);
@@ -307,7 +529,7 @@ void QtModule::render_rect_a(RenderOp op) {
     }
     else {
       for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-        BLRectI rect(_rnd_coord.next_rect_i(bounds, wh, wh));
+        BLRectI rect(next_rect_i(bounds, wh, wh));
         QBrush brush(create_brush<BLRectI>(style, rect));
 
         if (op == RenderOp::kStroke) {
@@ -334,8 +556,8 @@ void QtModule::render_rect_f(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-      QColor color(to_qt_color(_rnd_color.next_rgba32()));
+      BLRect rect(next_rect(bounds, wh, wh));
+      QColor color(to_qt_color(next_color()));
 
       if (op == RenderOp::kStroke) {
         _qt_context->setPen(color);
@@ -348,7 +570,7 @@ void QtModule::render_rect_f(RenderOp op) {
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+      BLRect rect(next_rect(bounds, wh, wh));
       QBrush brush(create_brush<BLRect>(style, rect));
 
       if (op == RenderOp::kStroke) {
@@ -365,6 +587,78 @@ void QtModule::render_rect_f(RenderOp op) {
   }
 }
 
+void QtModule::render_rect_a_batch(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  int wh = _params.shape_size;
+
+  QRect rects[kBenchBatchSize];
+  BLRectI style_rect(0, 0, bounds.w, bounds.h);
+
+  if (op == RenderOp::kStroke)
+    _qt_context->setBrush(Qt::NoBrush);
+  else
+    _qt_context->setPen(Qt::NoPen);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    for (uint32_t j = 0; j < n; j++) {
+      BLRectI rect(next_rect_i(bounds, wh, wh));
+      rects[j] = QRect(rect.x, rect.y, rect.w, rect.h);
+    }
+
+    QBrush brush(style == StyleKind::kSolid ? QBrush(to_qt_color(next_color())) : create_brush<BLRectI>(style, style_rect));
+
+    if (op == RenderOp::kStroke) {
+      QPen pen(brush, qreal(_params.stroke_width));
+      pen.setJoinStyle(Qt::MiterJoin);
+      _qt_context->setPen(pen);
+    }
+    else {
+      _qt_context->setBrush(brush);
+    }
+
+    _qt_context->drawRects(rects, int(n));
+  }
+}
+
+void QtModule::render_rect_f_batch(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  QRectF rects[kBenchBatchSize];
+  BLRect style_rect(0, 0, bounds.w, bounds.h);
+
+  if (op == RenderOp::kStroke)
+    _qt_context->setBrush(Qt::NoBrush);
+  else
+    _qt_context->setPen(Qt::NoPen);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    for (uint32_t j = 0; j < n; j++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+      rects[j] = QRectF(rect.x, rect.y, rect.w, rect.h);
+    }
+
+    QBrush brush(style == StyleKind::kSolid ? QBrush(to_qt_color(next_color())) : create_brush<BLRect>(style, style_rect));
+
+    if (op == RenderOp::kStroke) {
+      QPen pen(brush, qreal(_params.stroke_width));
+      pen.setJoinStyle(Qt::MiterJoin);
+      _qt_context->setPen(pen);
+    }
+    else {
+      _qt_context->setBrush(brush);
+    }
+
+    _qt_context->drawRects(rects, int(n));
+  }
+}
+
 void QtModule::render_rect_rotated(RenderOp op) {
   BLSize bounds(_params.screen_w, _params.screen_h);
   StyleKind style = _params.style;
@@ -372,13 +666,13 @@ void QtModule::render_rect_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   if (op == RenderOp::kStroke)
     _qt_context->setBrush(Qt::NoBrush);
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
+    BLRect rect(next_rect(bounds, wh, wh));
 
     QTransform transform;
     transform.translate(cx, cy);
@@ -387,7 +681,7 @@ void QtModule::render_rect_rotated(RenderOp op) {
     _qt_context->setTransform(transform, false);
 
     if (style == StyleKind::kSolid) {
-      QColor color(to_qt_color(_rnd_color.next_rgba32()));
+      QColor color(to_qt_color(next_color()));
 
       if (op == RenderOp::kStroke) {
         QPen pen(color, qreal(_params.stroke_width));
@@ -417,6 +711,8 @@ void QtModule::render_rect_rotated(RenderOp op) {
 
     _qt_context->resetTransform();
   }
+
+  _rotation_angle = angle;
 }
 
 void QtModule::render_round_f(RenderOp op) {
@@ -430,11 +726,11 @@ void QtModule::render_round_f(RenderOp op) {
     _qt_context->setPen(QPen(Qt::NoPen));
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect(next_rect(bounds, wh, wh));
+    double radius = next_radius();
 
     if (style == StyleKind::kSolid) {
-      QColor color(to_qt_color(_rnd_color.next_rgba32()));
+      QColor color(to_qt_color(next_color()));
 
       if (op == RenderOp::kStroke)
         _qt_context->setPen(QPen(color, qreal(_params.stroke_width)));
@@ -464,7 +760,7 @@ void QtModule::render_round_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   if (op == RenderOp::kStroke)
     _qt_context->setBrush(Qt::NoBrush);
@@ -472,8 +768,8 @@ void QtModule::render_round_rotated(RenderOp op) {
     _qt_context->setPen(QPen(Qt::NoPen));
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect(_rnd_coord.next_rect(bounds, wh, wh));
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect(next_rect(bounds, wh, wh));
+    double radius = next_radius();
 
     QTransform transform;
     transform.translate(cx, cy);
@@ -482,7 +778,7 @@ void QtModule::render_round_rotated(RenderOp op) {
     _qt_context->setTransform(transform, false);
 
     if (style == StyleKind::kSolid) {
-      QColor color(to_qt_color(_rnd_color.next_rgba32()));
+      QColor color(to_qt_color(next_color()));
       if (op == RenderOp::kStroke)
         _qt_context->setPen(QPen(color, qreal(_params.stroke_width)));
       else
@@ -503,38 +799,38 @@ void QtModule::render_round_rotated(RenderOp op) {
 
     _qt_context->resetTransform();
   }
+
+  _rotation_angle = angle;
 }
 
-void QtModule::render_polygon(RenderOp op, uint32_t complexity) {
+void QtModule::render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
   double wh = double(_params.shape_size);
+  QPen pen(to_qt_pen(stroke_options_of(_params.stroke)));
 
   Qt::FillRule fillRule = op == RenderOp::kFillEvenOdd ? Qt::OddEvenFill : Qt::WindingFill;
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base(next_origin(bounds));
 
-    double x = _rnd_coord.next_double(base.x, base.x + wh);
-    double y = _rnd_coord.next_double(base.y, base.y + wh);
+    BLPoint v = next_vertex(kind, base, wh, 0);
 
     QPainterPath path;
     path.setFillRule(fillRule);
-    path.moveTo(x, y);
+    path.moveTo(v.x, v.y);
 
     for (uint32_t p = 1; p < complexity; p++) {
-      x = _rnd_coord.next_double(base.x, base.x + wh);
-      y = _rnd_coord.next_double(base.y, base.y + wh);
-      path.lineTo(x, y);
+      v = next_vertex(kind, base, wh, p);
+      path.lineTo(v.x, v.y);
     }
 
     if (style == StyleKind::kSolid) {
-      QColor color(to_qt_color(_rnd_color.next_rgba32()));
+      QColor color(to_qt_color(next_color()));
 
       if (op == RenderOp::kStroke) {
-        QPen pen(color, qreal(_params.stroke_width));
-        pen.setJoinStyle(Qt::MiterJoin);
+        pen.setColor(color);
         _qt_context->strokePath(path, pen);
       }
       else {
@@ -546,8 +842,7 @@ void QtModule::render_polygon(RenderOp op, uint32_t complexity) {
       QBrush brush(create_brush<BLRect>(style, rect));
 
       if (op == RenderOp::kStroke) {
-        QPen pen(brush, qreal(_params.stroke_width));
-        pen.setJoinStyle(Qt::MiterJoin);
+        pen.setBrush(brush);
         _qt_context->strokePath(path, pen);
       }
       else {
@@ -561,69 +856,180 @@ void QtModule::render_shape(RenderOp op, ShapeData shape) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
+  ShapePathMode shape_path = _params.shape_path;
   double wh = double(_params.shape_size);
-
-  ShapeIterator it(shape);
-  QPainterPath path;
-  while (it.has_command()) {
-    if (it.is_move_to()) {
-      path.moveTo(it.x(0) * wh, it.y(0) * wh);
-    }
-    else if (it.is_line_to()) {
-      path.lineTo(it.x(0) * wh, it.y(0) * wh);
-    }
-    else if (it.is_quad_to()) {
-      path.quadTo(
-        it.x(0) * wh, it.y(0) * wh,
-        it.x(1) * wh, it.y(1) * wh);
-    }
-    else if (it.is_cubic_to()) {
-      path.cubicTo(
-        it.x(0) * wh, it.y(0) * wh,
-        it.x(1) * wh, it.y(1) * wh,
-        it.x(2) * wh, it.y(2) * wh);
-    }
-    else {
-      path.closeSubpath();
-    }
-    it.next();
-  }
+  QPen pen(to_qt_pen(stroke_options_of(_params.stroke)));
 
   Qt::FillRule fillRule = op == RenderOp::kFillEvenOdd ? Qt::OddEvenFill : Qt::WindingFill;
 
+  // The fill rule of the replayed and cached paths is set by before_run().
+  QPainterPath& path = _shape_path;
+
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base;
+    BLRect rect(0, 0, wh, wh);
+    const QPainterPath* p = &path;
+
+    if (shape_path == ShapePathMode::kCached) {
+      uint32_t index = next_cached_shape();
+      base = _cached_shape_origins[index];
+      rect.reset(base.x, base.y, wh, wh);
+      p = &_cached_paths[index];
+    }
+    else if (shape_path == ShapePathMode::kRebuild) {
+      base = next_origin(bounds);
+      rect.reset(base.x, base.y, wh, wh);
 
-    _qt_context->save();
-    _qt_context->translate(qreal(base.x), qreal(base.y));
+      path.clear();
+      add_shape_path(path, shape, wh, base);
+      path.setFillRule(fillRule);
+    }
+    else {
+      base = next_origin(bounds);
+
+      _qt_context->save();
+      _qt_context->translate(qreal(base.x), qreal(base.y));
+    }
 
     if (style == StyleKind::kSolid) {
-      QColor color(to_qt_color(_rnd_color.next_rgba32()));
+      QColor color(to_qt_color(next_color()));
 
       if (op == RenderOp::kStroke) {
-        QPen pen(color, qreal(_params.stroke_width));
-        pen.setJoinStyle(Qt::MiterJoin);
-        _qt_context->strokePath(path, pen);
+        pen.setColor(color);
+        _qt_context->strokePath(*p, pen);
       }
       else {
-        _qt_context->fillPath(path, QBrush(color));
+        _qt_context->fillPath(*p, QBrush(color));
       }
     }
     else {
-      BLRect rect(0, 0, wh, wh);
       QBrush brush(create_brush<BLRect>(style, rect));
 
       if (op == RenderOp::kStroke) {
-        QPen pen(brush, qreal(_params.stroke_width));
-        pen.setJoinStyle(Qt::MiterJoin);
-        _qt_context->strokePath(path, pen);
+        pen.setBrush(brush);
+        _qt_context->strokePath(*p, pen);
       }
       else {
-        _qt_context->fillPath(path, brush);
+        _qt_context->fillPath(*p, brush);
+      }
+    }
+
+    if (shape_path == ShapePathMode::kReplay)
+      _qt_context->restore();
+  }
+}
+
+void QtModule::render_text(TextKind kind) {
+  BLSizeI bounds(_params.screen_w - _params.shape_size,
+                 _params.screen_h - _params.shape_size);
+  StyleKind style = _params.style;
+  double wh = double(_params.shape_size);
+  double line_height = wh * kTextLineHeight;
+
+  TextData text;
+  get_text_data(text, kind);
+
+  // QString is the native string type of Qt, thus the text is converted only once.
+  QStringList lines;
+  for (size_t line = 0; line < text.line_count; line++)
+    lines.append(QString::fromUtf8(text.lines[line]));
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base(next_origin(bounds));
+
+    // Text is filled by the brush of the pen.
+    if (style == StyleKind::kSolid)
+      _qt_context->setPen(to_qt_color(next_color()));
+    else
+      _qt_context->setPen(QPen(create_brush<BLRect>(style, BLRect(base.x, base.y, wh, wh)), qreal(0)));
+
+    if (kind == TextKind::kGlyphRun) {
+      _qt_context->drawGlyphRun(QPointF(base.x, base.y + wh), _qt_glyph_run);
+    }
+    else {
+      for (qsizetype line = 0; line < lines.size(); line++) {
+        _qt_context->drawText(QPointF(base.x, base.y + wh + line_height * double(line)), lines.at(line));
       }
     }
+  }
+}
+
+void QtModule::render_blit_scaled(BLSizeI dst_size, bool fractional) {
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_blit_rect(dst_size, fractional));
+    const QImage& sprite = *_qt_sprites[nextSpriteId()];
+
+    _qt_context->drawImage(QRectF(rect.x, rect.y, rect.w, rect.h), sprite);
+  }
+}
+
+void QtModule::render_rect_clip(ClipMode mode) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  if (mode == ClipMode::kStatic) {
+    BLRectI clip = static_clip_rect();
+
+    _qt_context->save();
+    _qt_context->setClipRect(QRect(clip.x, clip.y, clip.w, clip.h));
+  }
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_rect(bounds, wh, wh));
+
+    if (mode == ClipMode::kNested) {
+      BLRect outer = clip_outer_rect(rect);
+      BLRect inner = clip_inner_rect(rect);
+
+      _qt_context->save();
+      _qt_context->setClipRect(QRectF(outer.x, outer.y, outer.w, outer.h), Qt::IntersectClip);
+      _qt_context->save();
+      _qt_context->setClipRect(QRectF(inner.x, inner.y, inner.w, inner.h), Qt::IntersectClip);
+    }
+    else if (mode == ClipMode::kPerCall) {
+      BLRect clip = clip_call_rect(rect);
+      _qt_context->setClipRect(QRectF(clip.x, clip.y, clip.w, clip.h), Qt::ReplaceClip);
+    }
+
+    if (style == StyleKind::kSolid)
+      _qt_context->fillRect(QRectF(rect.x, rect.y, rect.w, rect.h), to_qt_color(next_color()));
+    else
+      _qt_context->fillRect(QRectF(rect.x, rect.y, rect.w, rect.h), create_brush<BLRect>(style, rect));
+
+    if (mode == ClipMode::kNested) {
+      _qt_context->restore();
+      _qt_context->restore();
+    }
+  }
 
+  if (mode == ClipMode::kStatic)
     _qt_context->restore();
+  else if (mode == ClipMode::kPerCall)
+    _qt_context->setClipping(false);
+}
+
+void QtModule::render_gradient_stops(uint32_t stop_count, bool reuse) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  if (reuse) {
+    QBrush brush = create_gradient_brush(style, BLRect(0, 0, wh, wh), stop_count, _gradient_colors[0]);
+
+    for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+
+      _qt_context->translate(rect.x, rect.y);
+      _qt_context->fillRect(QRectF(0, 0, wh, wh), brush);
+      _qt_context->resetTransform();
+    }
+  }
+  else {
+    for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+      BLRect rect(next_rect(bounds, wh, wh));
+      _qt_context->fillRect(QRectF(rect.x, rect.y, rect.w, rect.h), create_gradient_brush(style, rect, stop_count, next_color()));
+    }
   }
 }
 
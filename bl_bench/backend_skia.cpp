@@ -11,10 +11,16 @@
 #include <skia/core/SkBitmap.h>
 #include <skia/core/SkCanvas.h>
 #include <skia/core/SkColor.h>
+#include <skia/core/SkData.h>
+#include <skia/core/SkFont.h>
+#include <skia/core/SkFontMgr.h>
 #include <skia/core/SkImageInfo.h>
 #include <skia/core/SkPaint.h>
 #include <skia/core/SkPath.h>
+#include <skia/core/SkTextBlob.h>
+#include <skia/core/SkTypeface.h>
 #include <skia/core/SkTypes.h>
+#include <skia/effects/SkDashPathEffect.h>
 #include <skia/effects/SkGradientShader.h>
 
 namespace blbench {
@@ -27,6 +33,39 @@ static inline SkRect to_sk_rect(const BLRect& rect) {
   return SkRect::MakeXYWH(SkScalar(rect.x), SkScalar(rect.y), SkScalar(rect.w), SkScalar(rect.h));
 }
 
+static inline SkImageInfo to_sk_image_info(int w, int h, BLFormat format) {
+  switch (format) {
+    case BL_FORMAT_XRGB32: return SkImageInfo::Make(w, h, kBGRA_8888_SkColorType, kOpaque_SkAlphaType);
+    case BL_FORMAT_A8    : return SkImageInfo::Make(w, h, kAlpha_8_SkColorType, kPremul_SkAlphaType);
+
+    default:
+      return SkImageInfo::Make(w, h, kBGRA_8888_SkColorType, kPremul_SkAlphaType);
+  }
+}
+
+static void setup_sk_stroke(SkPaint& p, const StrokeOptions& stroke) {
+  // Skia strokes hairlines if the stroke width is zero.
+  p.setStrokeWidth(stroke.hairline ? SkScalar(0) : SkScalar(stroke.width));
+  p.setStrokeMiter(SkScalar(kBenchMiterLimit));
+
+  switch (stroke.join) {
+    case StrokeJoin::kMiter: p.setStrokeJoin(SkPaint::kMiter_Join); break;
+    case StrokeJoin::kRound: p.setStrokeJoin(SkPaint::kRound_Join); break;
+    case StrokeJoin::kBevel: p.setStrokeJoin(SkPaint::kBevel_Join); break;
+  }
+
+  switch (stroke.cap) {
+    case StrokeCap::kButt  : p.setStrokeCap(SkPaint::kButt_Cap); break;
+    case StrokeCap::kRound : p.setStrokeCap(SkPaint::kRound_Cap); break;
+    case StrokeCap::kSquare: p.setStrokeCap(SkPaint::kSquare_Cap); break;
+  }
+
+  if (stroke.is_dashed()) {
+    SkScalar intervals[2] = { SkScalar(stroke.dash_on), SkScalar(stroke.dash_off) };
+    p.setPathEffect(SkDashPathEffect::Make(intervals, 2, 0));
+  }
+}
+
 static uint32_t to_sk_blend_mode(BLCompOp comp_op) {
   switch (comp_op) {
     case BL_COMP_OP_SRC_OVER   : return uint32_t(SkBlendMode::kSrcOver);
@@ -59,6 +98,37 @@ static uint32_t to_sk_blend_mode(BLCompOp comp_op) {
   }
 }
 
+// Adds `shape` scaled by `scale` and translated by `offset` to `path`.
+static void add_shape_path(SkPath& path, ShapeData shape, double scale, const BLPoint& offset) {
+  double x = offset.x;
+  double y = offset.y;
+
+  ShapeIterator it(shape);
+  while (it.has_command()) {
+    if (it.is_move_to()) {
+      path.moveTo(SkScalar(x + it.x(0) * scale), SkScalar(y + it.y(0) * scale));
+    }
+    else if (it.is_line_to()) {
+      path.lineTo(SkScalar(x + it.x(0) * scale), SkScalar(y + it.y(0) * scale));
+    }
+    else if (it.is_quad_to()) {
+      path.quadTo(
+        SkScalar(x + it.x(0) * scale), SkScalar(y + it.y(0) * scale),
+        SkScalar(x + it.x(1) * scale), SkScalar(y + it.y(1) * scale));
+    }
+    else if (it.is_cubic_to()) {
+      path.cubicTo(
+        SkScalar(x + it.x(0) * scale), SkScalar(y + it.y(0) * scale),
+        SkScalar(x + it.x(1) * scale), SkScalar(y + it.y(1) * scale),
+        SkScalar(x + it.x(2) * scale), SkScalar(y + it.y(2) * scale));
+    }
+    else {
+      path.close();
+    }
+    it.next();
+  }
+}
+
 struct SkiaModule final : public Backend {
   SkCanvas* _sk_canvas {};
   SkBitmap _sk_surface;
@@ -67,14 +137,33 @@ struct SkiaModule final : public Backend {
   SkBlendMode _blend_mode {};
   SkTileMode _gradient_tile_mode {};
 
+  // Initialized by before_run() of high vertex-count polygon tests.
+  std::vector<SkPoint> _polygon_points;
+
+  // Initialized by before_run() of shape tests - the path to replay (or to rebuild, which keeps its capacity across
+  // render calls) and paths of ShapePathMode::kCached.
+  SkPath _shape_path;
+  std::vector<SkPath> _cached_paths;
+
+  // Initialized by before_run() of text tests.
+  sk_sp<SkTypeface> _sk_typeface;
+  SkFont _sk_font;
+  sk_sp<SkTextBlob> _sk_glyph_run;
+
   SkiaModule();
   ~SkiaModule() override;
 
   template<typename RectT>
   sk_sp<SkShader> create_shader(StyleKind style, const RectT& rect);
 
+  sk_sp<SkShader> create_gradient_shader(StyleKind style, const BLRect& rect, uint32_t stop_count, BLRgba32 first_color);
+
   bool supports_comp_op(BLCompOp comp_op) const override;
   bool supports_style(StyleKind style) const override;
+  bool supports_format(BLFormat format) const override;
+  bool supports_test(TestKind test) const override;
+  bool supports_stroke(StrokeKind stroke) const override;
+  bool supports_shape_path(ShapePathMode shape_path) const override;
 
   void before_run() override;
   void flush() override;
@@ -82,11 +171,17 @@ struct SkiaModule final : public Backend {
 
   void render_rect_a(RenderOp op) override;
   void render_rect_f(RenderOp op) override;
+  void render_rect_a_batch(RenderOp op) override;
+  void render_rect_f_batch(RenderOp op) override;
   void render_rect_rotated(RenderOp op) override;
   void render_round_f(RenderOp op) override;
   void render_round_rotated(RenderOp op) override;
-  void render_polygon(RenderOp op, uint32_t complexity) override;
+  void render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) override;
   void render_shape(RenderOp op, ShapeData shape) override;
+  void render_text(TextKind kind) override;
+  void render_blit_scaled(BLSizeI dst_size, bool fractional) override;
+  void render_rect_clip(ClipMode mode) override;
+  void render_gradient_stops(uint32_t stop_count, bool reuse) override;
 };
 
 SkiaModule::SkiaModule() {
@@ -121,9 +216,9 @@ sk_sp<SkShader> SkiaModule::create_shader(StyleKind style, const RectT& rect) {
       };
 
       SkColor colors[3] = {
-        _rnd_color.next_rgba32().value,
-        _rnd_color.next_rgba32().value,
-        _rnd_color.next_rgba32().value
+        next_color().value,
+        next_color().value,
+        next_color().value
       };
 
       return SkGradientShader::MakeLinear(pts, colors, positions3, 3, _gradient_tile_mode);
@@ -139,9 +234,9 @@ sk_sp<SkShader> SkiaModule::create_shader(StyleKind style, const RectT& rect) {
       double fy = cy - cr / 2;
 
       SkColor colors[3] = {
-        _rnd_color.next_rgba32().value,
-        _rnd_color.next_rgba32().value,
-        _rnd_color.next_rgba32().value
+        next_color().value,
+        next_color().value,
+        next_color().value
       };
 
       return SkGradientShader::MakeTwoPointConical(
@@ -155,12 +250,12 @@ sk_sp<SkShader> SkiaModule::create_shader(StyleKind style, const RectT& rect) {
     case StyleKind::kConic: {
       double cx = rect.x + rect.w / 2;
       double cy = rect.y + rect.h / 2;
-      BLRgba32 c = _rnd_color.next_rgba32();
+      BLRgba32 c = next_color();
 
       SkColor colors[4] = {
         c.value,
-        _rnd_color.next_rgba32().value,
-        _rnd_color.next_rgba32().value,
+        next_color().value,
+        next_color().value,
         c.value
       };
 
@@ -181,6 +276,57 @@ sk_sp<SkShader> SkiaModule::create_shader(StyleKind style, const RectT& rect) {
   }
 }
 
+// Creates a gradient shader of `style` spanning `rect` having `stop_count` stops of `_gradient_colors` except the
+// first stop, which uses `first_color`. The geometry is the same as used by `create_shader()`.
+sk_sp<SkShader> SkiaModule::create_gradient_shader(StyleKind style, const BLRect& rect, uint32_t stop_count, BLRgba32 first_color) {
+  SkColor colors[kBenchMaxGradientStops];
+  SkScalar positions[kBenchMaxGradientStops];
+
+  for (uint32_t i = 0; i < stop_count; i++) {
+    colors[i] = i ? _gradient_colors[i].value : first_color.value;
+    positions[i] = SkScalar(gradient_stop_offset(i, stop_count));
+  }
+
+  switch (style) {
+    case StyleKind::kLinearPad:
+    case StyleKind::kLinearRepeat:
+    case StyleKind::kLinearReflect: {
+      SkPoint pts[2] = {
+        SkScalar(rect.x + rect.w * 0.2),
+        SkScalar(rect.y + rect.h * 0.2),
+        SkScalar(rect.x + rect.w * 0.8),
+        SkScalar(rect.y + rect.h * 0.8)
+      };
+
+      return SkGradientShader::MakeLinear(pts, colors, positions, int(stop_count), _gradient_tile_mode);
+    }
+
+    case StyleKind::kRadialPad:
+    case StyleKind::kRadialRepeat:
+    case StyleKind::kRadialReflect: {
+      double cx = rect.x + rect.w / 2.0;
+      double cy = rect.y + rect.h / 2.0;
+      double cr = (rect.w + rect.h) / 4.0;
+      double fx = cx - cr / 2;
+      double fy = cy - cr / 2;
+
+      return SkGradientShader::MakeTwoPointConical(
+        SkPoint::Make(SkScalar(cx), SkScalar(cy)),
+        SkScalar(cr),
+        SkPoint::Make(SkScalar(fx), SkScalar(fy)),
+        SkScalar(0.0),
+        colors, positions, int(stop_count), _gradient_tile_mode);
+    }
+
+    default: {
+      double cx = rect.x + rect.w / 2;
+      double cy = rect.y + rect.h / 2;
+
+      return SkGradientShader::MakeSweep(SkScalar(cx), SkScalar(cy), colors, positions, int(stop_count));
+    }
+  }
+}
+
 bool SkiaModule::supports_comp_op(BLCompOp comp_op) const {
   return to_sk_blend_mode(comp_op) != 0xFFFFFFFFu;
 }
@@ -198,6 +344,24 @@ bool SkiaModule::supports_style(StyleKind style) const {
          style == StyleKind::kPatternBI     ;
 }
 
+bool SkiaModule::supports_format(BLFormat format) const {
+  return format == BL_FORMAT_PRGB32 ||
+         format == BL_FORMAT_XRGB32 ||
+         format == BL_FORMAT_A8     ;
+}
+
+bool SkiaModule::supports_test(TestKind test) const {
+  return true;
+}
+
+bool SkiaModule::supports_stroke(StrokeKind stroke) const {
+  return true;
+}
+
+bool SkiaModule::supports_shape_path(ShapePathMode shape_path) const {
+  return true;
+}
+
 void SkiaModule::before_run() {
   int w = int(_params.screen_w);
   int h = int(_params.screen_h);
@@ -219,7 +383,7 @@ void SkiaModule::before_run() {
   _surface.create(w, h, _params.format);
   _surface.make_mutable(&surface_data);
 
-  SkImageInfo surface_info = SkImageInfo::Make(w, h, kBGRA_8888_SkColorType, kPremul_SkAlphaType);
+  SkImageInfo surface_info = to_sk_image_info(w, h, BLFormat(surface_data.format));
   _sk_surface.installPixels(surface_info, surface_data.pixel_data, size_t(surface_data.stride));
   _sk_surface.erase(0x00000000, SkIRect::MakeXYWH(0, 0, w, h));
 
@@ -240,6 +404,41 @@ void SkiaModule::before_run() {
     default:
       break;
   }
+
+  _polygon_points.resize(vertices_per_call(_params.testKind));
+
+  SkPathFillType shape_fill_type =
+    shape_render_op_of(_params.testKind) == RenderOp::kFillEvenOdd ? SkPathFillType::kEvenOdd : SkPathFillType::kWinding;
+
+  _shape_path.reset();
+  if (needs_replay_path())
+    add_shape_path(_shape_path, _cached_shape, double(_params.shape_size), BLPoint(0, 0));
+  _shape_path.setFillType(shape_fill_type);
+
+  _cached_paths.resize(_cached_shape_origins.size());
+  for (size_t i = 0; i < _cached_paths.size(); i++) {
+    _cached_paths[i].reset();
+    add_shape_path(_cached_paths[i], _cached_shape, double(_params.shape_size), _cached_shape_origins[i]);
+    _cached_paths[i].setFillType(shape_fill_type);
+  }
+
+  if (is_text_test(_params.testKind)) {
+    if (!_sk_typeface) {
+      size_t font_data_size;
+      const uint8_t* font_data = get_text_font_data(&font_data_size);
+      _sk_typeface = SkFontMgr::RefDefault()->makeFromData(SkData::MakeWithoutCopy(font_data, font_data_size));
+    }
+
+    _sk_font = SkFont(_sk_typeface, SkScalar(_params.shape_size));
+    _sk_font.setEdging(SkFont::Edging::kAntiAlias);
+
+    _sk_glyph_run.reset();
+    if (_params.testKind == TestKind::kFillGlyphRun) {
+      TextData text;
+      get_text_data(text, TextKind::kGlyphRun);
+      _sk_glyph_run = SkTextBlob::MakeFromString(text.lines[0], _sk_font);
+    }
+  }
 }
 
 void SkiaModule::flush() {
@@ -269,15 +468,15 @@ void SkiaModule::render_rect_a(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI rect = _rnd_coord.next_rect_i(bounds, wh, wh);
+      BLRectI rect = next_rect_i(bounds, wh, wh);
 
-      p.setColor(_rnd_color.next_rgba32().value);
+      p.setColor(next_color().value);
       _sk_canvas->drawIRect(to_sk_irect(rect), p);
     }
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRectI rect = _rnd_coord.next_rect_i(bounds, wh, wh);
+      BLRectI rect = next_rect_i(bounds, wh, wh);
 
       p.setShader(create_shader(style, rect));
       _sk_canvas->drawIRect(to_sk_irect(rect), p);
@@ -298,15 +497,15 @@ void SkiaModule::render_rect_f(RenderOp op) {
 
   if (style == StyleKind::kSolid) {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect rect = _rnd_coord.next_rect(bounds, wh, wh);
+      BLRect rect = next_rect(bounds, wh, wh);
 
-      p.setColor(_rnd_color.next_rgba32().value);
+      p.setColor(next_color().value);
       _sk_canvas->drawRect(to_sk_rect(rect), p);
     }
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLRect rect = _rnd_coord.next_rect(bounds, wh, wh);
+      BLRect rect = next_rect(bounds, wh, wh);
 
       p.setShader(create_shader(style, rect));
       _sk_canvas->drawRect(to_sk_rect(rect), p);
@@ -314,6 +513,65 @@ void SkiaModule::render_rect_f(RenderOp op) {
   }
 }
 
+void SkiaModule::render_rect_a_batch(RenderOp op) {
+  BLSizeI bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  int wh = _params.shape_size;
+
+  SkPaint p;
+  p.setStyle(op == RenderOp::kStroke ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
+  p.setAntiAlias(true);
+  p.setBlendMode(_blend_mode);
+  p.setStrokeWidth(SkScalar(_params.stroke_width));
+
+  // SKIA has no API that would render an array of rectangles, so each batch is rendered as a single path.
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    SkPath path;
+    for (uint32_t j = 0; j < n; j++) {
+      BLRectI rect = next_rect_i(bounds, wh, wh);
+      path.addRect(SkRect::Make(to_sk_irect(rect)));
+    }
+
+    if (style == StyleKind::kSolid)
+      p.setColor(next_color().value);
+    else
+      p.setShader(create_shader(style, BLRectI(0, 0, bounds.w, bounds.h)));
+
+    _sk_canvas->drawPath(path, p);
+  }
+}
+
+void SkiaModule::render_rect_f_batch(RenderOp op) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  SkPaint p;
+  p.setStyle(op == RenderOp::kStroke ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
+  p.setAntiAlias(true);
+  p.setBlendMode(_blend_mode);
+  p.setStrokeWidth(SkScalar(_params.stroke_width));
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i += kBenchBatchSize) {
+    uint32_t n = std::min(quantity - i, kBenchBatchSize);
+
+    SkPath path;
+    for (uint32_t j = 0; j < n; j++) {
+      BLRect rect = next_rect(bounds, wh, wh);
+      path.addRect(to_sk_rect(rect));
+    }
+
+    if (style == StyleKind::kSolid)
+      p.setColor(next_color().value);
+    else
+      p.setShader(create_shader(style, BLRect(0, 0, bounds.w, bounds.h)));
+
+    _sk_canvas->drawPath(path, p);
+  }
+}
+
 void SkiaModule::render_rect_rotated(RenderOp op) {
   BLSize bounds(_params.screen_w, _params.screen_h);
   StyleKind style = _params.style;
@@ -321,7 +579,7 @@ void SkiaModule::render_rect_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   SkPaint p;
   p.setStyle(op == RenderOp::kStroke ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
@@ -330,18 +588,20 @@ void SkiaModule::render_rect_rotated(RenderOp op) {
   p.setStrokeWidth(SkScalar(_params.stroke_width));
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
-    BLRect rect = _rnd_coord.next_rect(bounds, wh, wh);
+    BLRect rect = next_rect(bounds, wh, wh);
 
     _sk_canvas->rotate(SkRadiansToDegrees(angle), SkScalar(cx), SkScalar(cy));
 
     if (style == StyleKind::kSolid)
-      p.setColor(_rnd_color.next_rgba32().value);
+      p.setColor(next_color().value);
     else
       p.setShader(create_shader(style, rect));
 
     _sk_canvas->drawRect(to_sk_rect(rect), p);
     _sk_canvas->resetMatrix();
   }
+
+  _rotation_angle = angle;
 }
 
 void SkiaModule::render_round_f(RenderOp op) {
@@ -356,11 +616,11 @@ void SkiaModule::render_round_f(RenderOp op) {
   p.setStrokeWidth(SkScalar(_params.stroke_width));
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLRect rect = _rnd_coord.next_rect(bounds, wh, wh);
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect = next_rect(bounds, wh, wh);
+    double radius = next_radius();
 
     if (style == StyleKind::kSolid)
-      p.setColor(_rnd_color.next_rgba32().value);
+      p.setColor(next_color().value);
     else
       p.setShader(create_shader(style, rect));
 
@@ -375,7 +635,7 @@ void SkiaModule::render_round_rotated(RenderOp op) {
   double cx = double(_params.screen_w) * 0.5;
   double cy = double(_params.screen_h) * 0.5;
   double wh = _params.shape_size;
-  double angle = 0.0;
+  double angle = _rotation_angle;
 
   SkPaint p;
   p.setStyle(op == RenderOp::kStroke ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
@@ -386,62 +646,56 @@ void SkiaModule::render_round_rotated(RenderOp op) {
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++, angle += 0.01) {
     _sk_canvas->rotate(SkRadiansToDegrees(angle), SkScalar(cx), SkScalar(cy));
 
-    BLRect rect = _rnd_coord.next_rect(bounds, wh, wh);
-    double radius = _rnd_extra.next_double(4.0, 40.0);
+    BLRect rect = next_rect(bounds, wh, wh);
+    double radius = next_radius();
 
     if (style == StyleKind::kSolid)
-      p.setColor(_rnd_color.next_rgba32().value);
+      p.setColor(next_color().value);
     else
       p.setShader(create_shader(style, rect));
 
     _sk_canvas->drawRoundRect(to_sk_rect(rect), SkScalar(radius), SkScalar(radius), p);
     _sk_canvas->resetMatrix();
   }
-}
 
-void SkiaModule::render_polygon(RenderOp op, uint32_t complexity) {
-  static constexpr uint32_t kPointCapacity = 128;
+  _rotation_angle = angle;
+}
 
+void SkiaModule::render_polygon(RenderOp op, PolygonKind kind, uint32_t complexity) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
   double wh = double(_params.shape_size);
 
-  if (complexity > kPointCapacity) {
-    return;
-  }
-
-  SkPoint points[kPointCapacity];
+  SkPoint stack_points[kBenchMaxStackVertices];
+  SkPoint* points = complexity <= kBenchMaxStackVertices ? stack_points : _polygon_points.data();
 
   SkPaint p;
   p.setStyle(op == RenderOp::kStroke ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
   p.setAntiAlias(true);
   p.setBlendMode(_blend_mode);
-  p.setStrokeWidth(SkScalar(_params.stroke_width));
+  setup_sk_stroke(p, stroke_options_of(_params.stroke));
 
   // SKIA cannot draw a polygon without having a path, so we have two cases here.
   if (op != RenderOp::kStroke) {
     SkPathFillType fillType = op == RenderOp::kFillEvenOdd ? SkPathFillType::kEvenOdd : SkPathFillType::kWinding;
 
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLPoint base(_rnd_coord.nextPoint(bounds));
+      BLPoint base(next_origin(bounds));
 
       SkPath path;
       path.setFillType(fillType);
 
-      double x, y;
-      x = _rnd_coord.next_double(base.x, base.x + wh);
-      y = _rnd_coord.next_double(base.y, base.y + wh);
-      path.moveTo(SkPoint::Make(SkScalar(x), SkScalar(y)));
+      BLPoint v = next_vertex(kind, base, wh, 0);
+      path.moveTo(SkPoint::Make(SkScalar(v.x), SkScalar(v.y)));
 
       for (uint32_t j = 1; j < complexity; j++) {
-        x = _rnd_coord.next_double(base.x, base.x + wh);
-        y = _rnd_coord.next_double(base.y, base.y + wh);
-        path.lineTo(SkPoint::Make(SkScalar(x), SkScalar(y)));
+        v = next_vertex(kind, base, wh, j);
+        path.lineTo(SkPoint::Make(SkScalar(v.x), SkScalar(v.y)));
       }
 
       if (style == StyleKind::kSolid) {
-        p.setColor(_rnd_color.next_rgba32().value);
+        p.setColor(next_color().value);
       }
       else {
         BLRect rect(base.x, base.y, wh, wh);
@@ -453,16 +707,15 @@ void SkiaModule::render_polygon(RenderOp op, uint32_t complexity) {
   }
   else {
     for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-      BLPoint base(_rnd_coord.nextPoint(bounds));
+      BLPoint base(next_origin(bounds));
 
       for (uint32_t j = 0; j < complexity; j++) {
-        double x = _rnd_coord.next_double(base.x, base.x + wh);
-        double y = _rnd_coord.next_double(base.y, base.y + wh);
-        points[j].set(SkScalar(x), SkScalar(y));
+        BLPoint v = next_vertex(kind, base, wh, j);
+        points[j].set(SkScalar(v.x), SkScalar(v.y));
       }
 
       if (style == StyleKind::kSolid) {
-        p.setColor(_rnd_color.next_rgba32().value);
+        p.setColor(next_color().value);
       }
       else {
         BLRect rect(base.x, base.y, wh, wh);
@@ -478,59 +731,189 @@ void SkiaModule::render_shape(RenderOp op, ShapeData shape) {
   BLSizeI bounds(_params.screen_w - _params.shape_size,
                  _params.screen_h - _params.shape_size);
   StyleKind style = _params.style;
+  ShapePathMode shape_path = _params.shape_path;
   double wh = double(_params.shape_size);
 
   SkPathFillType fillType = op == RenderOp::kFillEvenOdd ? SkPathFillType::kEvenOdd : SkPathFillType::kWinding;
 
-  SkPath path;
-  path.setFillType(fillType);
+  // The fill type of the replayed and cached paths is set by before_run().
+  SkPath& path = _shape_path;
 
-  ShapeIterator it(shape);
-  while (it.has_command()) {
-    if (it.is_move_to()) {
-      path.moveTo(SkScalar(it.x(0) * wh), SkScalar(it.y(0) * wh));
+  SkPaint p;
+  p.setStyle(op == RenderOp::kStroke ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
+  p.setAntiAlias(true);
+  p.setBlendMode(_blend_mode);
+  setup_sk_stroke(p, stroke_options_of(_params.stroke));
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLPoint base;
+    BLRect rect(0, 0, wh, wh);
+    const SkPath* sk_path = &path;
+
+    if (shape_path == ShapePathMode::kCached) {
+      uint32_t index = next_cached_shape();
+      base = _cached_shape_origins[index];
+      rect.reset(base.x, base.y, wh, wh);
+      sk_path = &_cached_paths[index];
     }
-    else if (it.is_line_to()) {
-      path.lineTo(SkScalar(it.x(0) * wh), SkScalar(it.y(0) * wh));
+    else if (shape_path == ShapePathMode::kRebuild) {
+      base = next_origin(bounds);
+      rect.reset(base.x, base.y, wh, wh);
+
+      path.rewind();
+      add_shape_path(path, shape, wh, base);
+      path.setFillType(fillType);
     }
-    else if (it.is_quad_to()) {
-      path.quadTo(
-        SkScalar(it.x(0) * wh), SkScalar(it.y(0) * wh),
-        SkScalar(it.x(1) * wh), SkScalar(it.y(1) * wh));
+    else {
+      base = next_origin(bounds);
+      _sk_canvas->translate(SkScalar(base.x), SkScalar(base.y));
     }
-    else if (it.is_cubic_to()) {
-      path.cubicTo(
-        SkScalar(it.x(0) * wh), SkScalar(it.y(0) * wh),
-        SkScalar(it.x(1) * wh), SkScalar(it.y(1) * wh),
-        SkScalar(it.x(2) * wh), SkScalar(it.y(2) * wh));
+
+    if (style == StyleKind::kSolid) {
+      p.setColor(next_color().value);
     }
     else {
-      path.close();
+      p.setShader(create_shader(style, rect));
     }
-    it.next();
+
+    _sk_canvas->drawPath(*sk_path, p);
+
+    if (shape_path == ShapePathMode::kReplay)
+      _sk_canvas->resetMatrix();
   }
+}
+
+void SkiaModule::render_text(TextKind kind) {
+  BLSizeI bounds(_params.screen_w - _params.shape_size,
+                 _params.screen_h - _params.shape_size);
+  StyleKind style = _params.style;
+  double wh = double(_params.shape_size);
+  double line_height = wh * kTextLineHeight;
+
+  TextData text;
+  get_text_data(text, kind);
 
   SkPaint p;
-  p.setStyle(op == RenderOp::kStroke ? SkPaint::kStroke_Style : SkPaint::kFill_Style);
   p.setAntiAlias(true);
   p.setBlendMode(_blend_mode);
-  p.setStrokeWidth(SkScalar(_params.stroke_width));
 
   for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
-    BLPoint base(_rnd_coord.nextPoint(bounds));
+    BLPoint base(next_origin(bounds));
 
-    _sk_canvas->translate(SkScalar(base.x), SkScalar(base.y));
+    if (style == StyleKind::kSolid)
+      p.setColor(next_color().value);
+    else
+      p.setShader(create_shader(style, BLRect(base.x, base.y, wh, wh)));
 
-    if (style == StyleKind::kSolid) {
-      p.setColor(_rnd_color.next_rgba32().value);
+    if (kind == TextKind::kGlyphRun) {
+      _sk_canvas->drawTextBlob(_sk_glyph_run, SkScalar(base.x), SkScalar(base.y + wh), p);
     }
     else {
-      BLRect rect(0, 0, wh, wh);
+      for (size_t line = 0; line < text.line_count; line++) {
+        const char* str = text.lines[line];
+        _sk_canvas->drawSimpleText(str, strlen(str), SkTextEncoding::kUTF8,
+          SkScalar(base.x), SkScalar(base.y + wh + line_height * double(line)), _sk_font, p);
+      }
+    }
+  }
+}
+
+void SkiaModule::render_blit_scaled(BLSizeI dst_size, bool fractional) {
+  SkFilterMode filter_mode = _params.style == StyleKind::kPatternNN ? SkFilterMode::kNearest : SkFilterMode::kLinear;
+
+  SkPaint p;
+  p.setAntiAlias(true);
+  p.setBlendMode(_blend_mode);
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect(next_blit_rect(dst_size, fractional));
+    const SkBitmap& sprite = _sk_sprites[nextSpriteId()];
+
+    SkMatrix m = SkMatrix::Translate(SkScalar(rect.x), SkScalar(rect.y));
+    m.preScale(SkScalar(rect.w / double(sprite.width())), SkScalar(rect.h / double(sprite.height())));
+
+    p.setShader(sprite.makeShader(SkTileMode::kClamp, SkTileMode::kClamp, SkSamplingOptions(filter_mode), &m));
+    _sk_canvas->drawRect(to_sk_rect(rect), p);
+  }
+}
+
+void SkiaModule::render_rect_clip(ClipMode mode) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  SkPaint p;
+  p.setAntiAlias(true);
+  p.setBlendMode(_blend_mode);
+
+  if (mode == ClipMode::kStatic) {
+    BLRectI clip = static_clip_rect();
+
+    _sk_canvas->save();
+    _sk_canvas->clipRect(SkRect::MakeXYWH(SkScalar(clip.x), SkScalar(clip.y), SkScalar(clip.w), SkScalar(clip.h)));
+  }
+
+  for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+    BLRect rect = next_rect(bounds, wh, wh);
+
+    // Skia has no way to replace the clip, thus a clip that changes per call needs its own save/restore scope.
+    if (mode == ClipMode::kNested) {
+      _sk_canvas->save();
+      _sk_canvas->clipRect(to_sk_rect(clip_outer_rect(rect)), true);
+      _sk_canvas->save();
+      _sk_canvas->clipRect(to_sk_rect(clip_inner_rect(rect)), true);
+    }
+    else if (mode == ClipMode::kPerCall) {
+      _sk_canvas->save();
+      _sk_canvas->clipRect(to_sk_rect(clip_call_rect(rect)), true);
+    }
+
+    if (style == StyleKind::kSolid)
+      p.setColor(next_color().value);
+    else
       p.setShader(create_shader(style, rect));
+    _sk_canvas->drawRect(to_sk_rect(rect), p);
+
+    if (mode == ClipMode::kNested) {
+      _sk_canvas->restore();
+      _sk_canvas->restore();
+    }
+    else if (mode == ClipMode::kPerCall) {
+      _sk_canvas->restore();
     }
+  }
 
-    _sk_canvas->drawPath(path, p);
-    _sk_canvas->resetMatrix();
+  if (mode == ClipMode::kStatic)
+    _sk_canvas->restore();
+}
+
+void SkiaModule::render_gradient_stops(uint32_t stop_count, bool reuse) {
+  BLSize bounds(_params.screen_w, _params.screen_h);
+  StyleKind style = _params.style;
+  double wh = _params.shape_size;
+
+  SkPaint p;
+  p.setAntiAlias(true);
+  p.setBlendMode(_blend_mode);
+
+  if (reuse) {
+    p.setShader(create_gradient_shader(style, BLRect(0, 0, wh, wh), stop_count, _gradient_colors[0]));
+
+    for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+      BLRect rect = next_rect(bounds, wh, wh);
+
+      _sk_canvas->translate(SkScalar(rect.x), SkScalar(rect.y));
+      _sk_canvas->drawRect(SkRect::MakeWH(SkScalar(wh), SkScalar(wh)), p);
+      _sk_canvas->resetMatrix();
+    }
+  }
+  else {
+    for (uint32_t i = 0, quantity = _params.quantity; i < quantity; i++) {
+      BLRect rect = next_rect(bounds, wh, wh);
+
+      p.setShader(create_gradient_shader(style, rect, stop_count, next_color()));
+      _sk_canvas->drawRect(to_sk_rect(rect), p);
+    }
   }
 }
 
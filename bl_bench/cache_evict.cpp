@@ -0,0 +1,90 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "cache_evict.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+  #define BLBENCH_CACHE_USE_CLFLUSH
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #else
+    #include <x86intrin.h>
+  #endif
+#endif
+
+#if defined(__linux__)
+  #include <unistd.h>
+#endif
+
+namespace blbench {
+
+static constexpr size_t kCacheLineSize = 64;
+static constexpr size_t kMinEvictionSize = 32u * 1024u * 1024u;
+
+// Keeps the result of reads, so the compiler cannot remove them.
+static std::atomic<uint32_t> cache_evict_sink;
+
+size_t CacheEvictor::default_size() {
+  size_t llc_size = 0;
+
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+  long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if (l3 > 0)
+    llc_size = size_t(l3);
+#endif
+
+  return std::max(llc_size * 2u, kMinEvictionSize);
+}
+
+void CacheEvictor::init(size_t size) {
+  // The buffer must be written, otherwise all pages could be mapped to a single zero page.
+  _buffer.assign(size, uint8_t(1));
+}
+
+void CacheEvictor::evict() const {
+  const uint8_t* p = _buffer.data();
+  size_t size = _buffer.size();
+  uint32_t sum = 0;
+
+  for (size_t i = 0; i < size; i += kCacheLineSize)
+    sum += p[i];
+
+  cache_evict_sink.fetch_add(sum, std::memory_order_relaxed);
+}
+
+void CacheEvictor::flush_memory(const void* p, size_t size) {
+#if defined(BLBENCH_CACHE_USE_CLFLUSH)
+  const uint8_t* start = static_cast<const uint8_t*>(p);
+  const uint8_t* end = start + size;
+
+  for (const uint8_t* line = start; line < end; line += kCacheLineSize)
+    _mm_clflush(line);
+  _mm_mfence();
+#else
+  (void)p;
+  (void)size;
+#endif
+}
+
+void CacheEvictor::flush_image(const BLImage& image) {
+  BLImageData data;
+  if (image.get_data(&data) != BL_SUCCESS || !data.pixel_data)
+    return;
+
+  intptr_t stride = data.stride;
+  size_t size = size_t(stride < 0 ? -stride : stride) * size_t(data.size.h);
+  const uint8_t* start = static_cast<const uint8_t*>(data.pixel_data);
+
+  // Negative stride means that the first scanline is at the end of the pixel data.
+  if (stride < 0)
+    start += stride * intptr_t(data.size.h - 1);
+
+  flush_memory(start, size);
+}
+
+} // {blbench}
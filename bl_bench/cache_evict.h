@@ -0,0 +1,43 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_CACHE_EVICT_H
+#define BLBENCH_CACHE_EVICT_H
+
+#include <blend2d.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace blbench {
+
+// blbench::CacheEvictor
+// =====================
+
+//! Evicts CPU caches by reading a buffer that is larger than the last level cache (used by `--cold` mode).
+//!
+//! The buffer is only read by `evict()`, so it can be used by multiple threads concurrently. Memory of images can
+//! additionally be flushed by `flush_image()`, which uses CLFLUSH on X86 and does nothing elsewhere.
+class CacheEvictor {
+public:
+  std::vector<uint8_t> _buffer;
+
+  //! Returns the size of the eviction buffer, which is twice the size of the last level cache if known.
+  static size_t default_size();
+
+  void init(size_t size);
+  void evict() const;
+
+  inline size_t size() const { return _buffer.size(); }
+
+  static void flush_memory(const void* p, size_t size);
+  static void flush_image(const BLImage& image);
+};
+
+} // {blbench}
+
+#endif // BLBENCH_CACHE_EVICT_H
@@ -0,0 +1,89 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "calibration_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace blbench {
+
+static const char calibration_cache_magic[] = "bl_bench-calibration-cache 1";
+
+// Reads a single line without trailing line break characters.
+static bool read_line(FILE* f, char* line, size_t capacity) {
+  if (!fgets(line, int(capacity), f))
+    return false;
+
+  size_t size = strlen(line);
+  while (size && (line[size - 1] == '\n' || line[size - 1] == '\r'))
+    line[--size] = '\0';
+  return true;
+}
+
+bool CalibrationCache::load(const char* file_name, const char* fingerprint) {
+  _quantities.clear();
+  _fingerprint = fingerprint;
+  _dirty = false;
+
+  FILE* f = fopen(file_name, "rb");
+  if (!f)
+    return false;
+
+  char line[1024];
+  bool valid = read_line(f, line, sizeof(line)) && strcmp(line, calibration_cache_magic) == 0 &&
+               read_line(f, line, sizeof(line)) && _fingerprint == line;
+
+  if (valid) {
+    while (read_line(f, line, sizeof(line))) {
+      char* tab = strchr(line, '\t');
+      if (!tab)
+        continue;
+
+      *tab = '\0';
+      unsigned long quantity = strtoul(tab + 1, nullptr, 10);
+
+      if (quantity)
+        _quantities[std::string(line)] = uint32_t(quantity);
+    }
+  }
+
+  fclose(f);
+  return valid;
+}
+
+bool CalibrationCache::save(const char* file_name) {
+  if (!_dirty)
+    return true;
+
+  FILE* f = fopen(file_name, "wb");
+  if (!f)
+    return false;
+
+  fprintf(f, "%s\n%s\n", calibration_cache_magic, _fingerprint.c_str());
+  for (const auto& kv : _quantities) {
+    fprintf(f, "%s\t%u\n", kv.first.c_str(), kv.second);
+  }
+
+  bool ok = fclose(f) == 0;
+  _dirty = !ok;
+  return ok;
+}
+
+uint32_t CalibrationCache::get(const std::string& key) const {
+  auto it = _quantities.find(key);
+  return it != _quantities.end() ? it->second : 0u;
+}
+
+void CalibrationCache::set(const std::string& key, uint32_t quantity) {
+  uint32_t& value = _quantities[key];
+  if (value != quantity) {
+    value = quantity;
+    _dirty = true;
+  }
+}
+
+} // {blbench}
@@ -0,0 +1,47 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_CALIBRATION_CACHE_H
+#define BLBENCH_CALIBRATION_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+
+namespace blbench {
+
+// blbench::CalibrationCache
+// =========================
+
+//! Persistent cache of calibrated quantities (render calls per run) of tests that use auto quantity.
+//!
+//! The cache is a text file, which starts with a fingerprint of the environment (build info, CPU brand, and target
+//! duration) followed by `key<TAB>quantity` lines. A cache having a different fingerprint is discarded on load.
+class CalibrationCache {
+public:
+  std::unordered_map<std::string, uint32_t> _quantities;
+  std::string _fingerprint;
+  bool _dirty = false;
+
+  //! Loads the cache from `file_name` - the cache is empty if the file doesn't exist or its fingerprint differs.
+  //!
+  //! Returns true if the cache was loaded.
+  bool load(const char* file_name, const char* fingerprint);
+
+  //! Saves the cache to `file_name` if it was modified since it was loaded or saved.
+  bool save(const char* file_name);
+
+  //! Returns a cached quantity of `key` or zero if not cached.
+  uint32_t get(const std::string& key) const;
+  void set(const std::string& key, uint32_t quantity);
+
+  inline size_t size() const { return _quantities.size(); }
+};
+
+} // {blbench}
+
+#endif // BLBENCH_CALIBRATION_CACHE_H
@@ -0,0 +1,70 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "image_diff.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+namespace blbench {
+
+double ImageDiff::psnr() const {
+  return 10.0 * log10((255.0 * 255.0) / mse);
+}
+
+bool compare_images(ImageDiff& out, const BLImage& image, const BLImage& reference) {
+  out.reset();
+
+  BLImageData a;
+  BLImageData b;
+
+  if (image.get_data(&a) != BL_SUCCESS || reference.get_data(&b) != BL_SUCCESS)
+    return false;
+
+  if (a.size.w != b.size.w || a.size.h != b.size.h || a.format != b.format)
+    return false;
+
+  uint32_t w = uint32_t(a.size.w);
+  uint32_t h = uint32_t(a.size.h);
+
+  // Bytes per pixel and a mask of channels to compare (byte per channel, the X byte of XRGB32 is ignored).
+  uint32_t bpp = a.format == BL_FORMAT_A8 ? 1u : 4u;
+  uint32_t channel_mask = a.format == BL_FORMAT_XRGB32 ? 0x7u : (1u << bpp) - 1u;
+  uint32_t channel_count = 0;
+
+  for (uint32_t c = 0; c < bpp; c++)
+    channel_count += (channel_mask >> c) & 1u;
+
+  uint64_t error_sum = 0;
+
+  for (uint32_t y = 0; y < h; y++) {
+    const uint8_t* pa = static_cast<const uint8_t*>(a.pixel_data) + intptr_t(y) * a.stride;
+    const uint8_t* pb = static_cast<const uint8_t*>(b.pixel_data) + intptr_t(y) * b.stride;
+
+    for (uint32_t x = 0; x < w; x++, pa += bpp, pb += bpp) {
+      uint32_t pixel_error = 0;
+
+      for (uint32_t c = 0; c < bpp; c++) {
+        if (!((channel_mask >> c) & 1u))
+          continue;
+
+        uint32_t e = uint32_t(abs(int(pa[c]) - int(pb[c])));
+        error_sum += e * e;
+        pixel_error |= e;
+
+        if (out.max_error < e)
+          out.max_error = e;
+      }
+
+      out.diff_pixels += uint64_t(pixel_error != 0);
+    }
+  }
+
+  uint64_t sample_count = uint64_t(w) * h * channel_count;
+  out.mse = sample_count ? double(error_sum) / double(sample_count) : 0.0;
+  return true;
+}
+
+} // {blbench}
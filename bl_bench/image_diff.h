@@ -0,0 +1,40 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_IMAGE_DIFF_H
+#define BLBENCH_IMAGE_DIFF_H
+
+#include <blend2d.h>
+
+namespace blbench {
+
+// blbench::ImageDiff
+// ==================
+
+//! Difference between a rendered image and a reference image.
+struct ImageDiff {
+  //! Maximum difference of a single channel (0..255).
+  uint32_t max_error;
+  //! Number of pixels that differ in at least one channel.
+  uint64_t diff_pixels;
+  //! Mean squared error of all channels.
+  double mse;
+
+  inline void reset() { *this = ImageDiff{}; }
+
+  inline bool is_exact() const { return diff_pixels == 0; }
+
+  //! Peak signal-to-noise ratio [dB], only meaningful if the images are not identical (`mse > 0`).
+  double psnr() const;
+};
+
+//! Compares `image` with `reference`, both must have the same size and pixel format.
+//!
+//! The unused channel of `BL_FORMAT_XRGB32` images is not compared. Returns false if the images are not comparable.
+bool compare_images(ImageDiff& out, const BLImage& image, const BLImage& reference);
+
+} // {blbench}
+
+#endif // BLBENCH_IMAGE_DIFF_H
@@ -0,0 +1,162 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "latency.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+  #define BLBENCH_LATENCY_USE_TSC
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #else
+    #include <x86intrin.h>
+  #endif
+#endif
+
+namespace blbench {
+
+// blbench::LatencyTimer
+// =====================
+
+namespace LatencyTimer {
+
+#if defined(BLBENCH_LATENCY_USE_TSC)
+
+uint64_t now() {
+  _mm_lfence();
+  uint64_t ticks = __rdtsc();
+  _mm_lfence();
+  return ticks;
+}
+
+// TSC frequency is not reported by the CPU in a portable way, so it's measured against a steady clock once.
+static double calibrate_ns_per_tick() {
+  using Clock = std::chrono::steady_clock;
+
+  Clock::time_point start_time = Clock::now();
+  uint64_t start_ticks = now();
+
+  Clock::time_point end_time;
+  do {
+    end_time = Clock::now();
+  } while (end_time - start_time < std::chrono::milliseconds(20));
+
+  uint64_t end_ticks = now();
+  double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+
+  return ns / double(std::max<uint64_t>(end_ticks - start_ticks, 1u));
+}
+
+static double ns_per_tick;
+
+void calibrate() {
+  if (ns_per_tick == 0.0)
+    ns_per_tick = calibrate_ns_per_tick();
+}
+
+uint64_t ticks_to_ns(uint64_t ticks) {
+  // Only calibrates here if `calibrate()` was not called before the measurement.
+  calibrate();
+  return uint64_t(double(ticks) * ns_per_tick + 0.5);
+}
+
+#else
+
+void calibrate() {}
+
+uint64_t now() {
+  return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t ticks_to_ns(uint64_t ticks) {
+  return ticks;
+}
+
+#endif
+
+} // {LatencyTimer}
+
+// blbench::LatencyHistogram
+// =========================
+
+static inline uint32_t bit_scan_reverse(uint64_t value) {
+  uint32_t index = 0;
+  while (value >>= 1)
+    index++;
+  return index;
+}
+
+static inline uint32_t bucket_index_of(uint64_t value) {
+  if (value < LatencyHistogram::kSubBucketCount)
+    return uint32_t(value);
+
+  uint32_t msb = bit_scan_reverse(value);
+  uint32_t shift = msb - LatencyHistogram::kSubBucketBits;
+  uint32_t sub = uint32_t(value >> shift) & (LatencyHistogram::kSubBucketCount - 1);
+
+  return LatencyHistogram::kSubBucketCount + shift * LatencyHistogram::kSubBucketCount + sub;
+}
+
+static inline uint64_t highest_value_of_bucket(uint32_t index) {
+  if (index < LatencyHistogram::kSubBucketCount)
+    return index;
+
+  uint32_t shift = (index - LatencyHistogram::kSubBucketCount) / LatencyHistogram::kSubBucketCount;
+  uint32_t sub = (index - LatencyHistogram::kSubBucketCount) % LatencyHistogram::kSubBucketCount;
+  uint64_t lowest = uint64_t(LatencyHistogram::kSubBucketCount + sub) << shift;
+
+  return lowest + ((uint64_t(1) << shift) - 1u);
+}
+
+void LatencyHistogram::reset() {
+  _buckets.assign(kBucketCount, 0u);
+  _count = 0;
+  _max = 0;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+  if (_buckets.empty())
+    reset();
+
+  _buckets[bucket_index_of(value)]++;
+  _count++;
+  _max = std::max(_max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  if (!other._count)
+    return;
+
+  if (_buckets.empty())
+    reset();
+
+  for (uint32_t i = 0; i < kBucketCount; i++)
+    _buckets[i] += other._buckets[i];
+
+  _count += other._count;
+  _max = std::max(_max, other._max);
+}
+
+uint64_t LatencyHistogram::value_at_percentile(double p) const {
+  if (!_count)
+    return 0;
+
+  uint64_t target = uint64_t(double(_count) * std::min(std::max(p, 0.0), 100.0) / 100.0 + 0.5);
+  target = std::max<uint64_t>(target, 1u);
+
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < kBucketCount; i++) {
+    seen += _buckets[i];
+    if (seen >= target)
+      return std::min(highest_value_of_bucket(i), _max);
+  }
+
+  return _max;
+}
+
+} // {blbench}
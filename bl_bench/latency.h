@@ -0,0 +1,65 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_LATENCY_H
+#define BLBENCH_LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace blbench {
+
+// blbench::LatencyTimer
+// =====================
+
+//! Low overhead timestamps used to measure individual render calls.
+//!
+//! Uses TSC fenced by LFENCE on X86 (so the measured instructions cannot be reordered across the timestamp) and
+//! a steady clock elsewhere. Timestamps are in ticks, use `ticks_to_ns()` to convert them to nanoseconds.
+namespace LatencyTimer {
+
+//! Measures the duration of a tick (takes about 20ms with TSC), must be called before any measurement starts.
+void calibrate();
+
+uint64_t now();
+uint64_t ticks_to_ns(uint64_t ticks);
+
+} // {LatencyTimer}
+
+// blbench::LatencyHistogram
+// =========================
+
+//! Log-linear (HDR-like) histogram of latencies in nanoseconds.
+//!
+//! Values below `kSubBucketCount` are recorded exactly, larger values are recorded with a relative error lower
+//! than `1 / kSubBucketCount` (about 3%). The maximum is always recorded exactly.
+class LatencyHistogram {
+public:
+  enum : uint32_t {
+    kSubBucketBits = 5,
+    kSubBucketCount = 1u << kSubBucketBits,
+    kBucketCount = kSubBucketCount + (64 - kSubBucketBits) * kSubBucketCount
+  };
+
+  std::vector<uint64_t> _buckets;
+  uint64_t _count {};
+  uint64_t _max {};
+
+  inline uint64_t count() const { return _count; }
+  inline uint64_t max() const { return _max; }
+
+  void reset();
+  void record(uint64_t value);
+  void merge(const LatencyHistogram& other);
+
+  //! Returns the highest value equivalent to the value at the given percentile `p` (0..100).
+  uint64_t value_at_percentile(double p) const;
+};
+
+} // {blbench}
+
+#endif // BLBENCH_LATENCY_H
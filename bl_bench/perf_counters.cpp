@@ -0,0 +1,165 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "perf_counters.h"
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #include <string.h>
+#endif // __linux__
+
+namespace blbench {
+
+static const char* perf_counter_name_table[kPerfCounterKindCount] = {
+  "cycles",
+  "instructions",
+  "branchMisses",
+  "stalledCyclesFrontend",
+  "stalledCyclesBackend",
+  "l1dMisses",
+  "llcMisses"
+};
+
+const char* perf_counter_name(PerfCounterKind kind) {
+  return perf_counter_name_table[uint32_t(kind)];
+}
+
+PerfCounters::PerfCounters() {}
+PerfCounters::~PerfCounters() { close(); }
+
+#if defined(__linux__)
+
+struct PerfEventInfo {
+  PerfCounterKind kind;
+  uint32_t type;
+  uint64_t config;
+};
+
+static const PerfEventInfo perf_core_group[] = {
+  { PerfCounterKind::kCycles               , PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { PerfCounterKind::kInstructions         , PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { PerfCounterKind::kBranchMisses         , PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  { PerfCounterKind::kStalledCyclesFrontend, PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND },
+  { PerfCounterKind::kStalledCyclesBackend , PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND }
+};
+
+static const PerfEventInfo perf_cache_group[] = {
+  { PerfCounterKind::kL1DMisses, PERF_TYPE_HW_CACHE, uint64_t(PERF_COUNT_HW_CACHE_L1D) |
+                                                     (uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8) |
+                                                     (uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16) },
+  { PerfCounterKind::kLLCMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES }
+};
+
+static int open_perf_event(const PerfEventInfo& info, int group_fd) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+
+  attr.size = sizeof(attr);
+  attr.type = info.type;
+  attr.config = info.config;
+  attr.disabled = group_fd == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return int(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+static void open_perf_group(PerfCounters::Group& group, const PerfEventInfo* events, size_t event_count) {
+  for (size_t i = 0; i < event_count; i++) {
+    int fd = open_perf_event(events[i], group.count ? group.fds[0] : -1);
+    if (fd < 0)
+      continue;
+
+    group.fds[group.count] = fd;
+    group.kinds[group.count] = events[i].kind;
+    group.count++;
+  }
+}
+
+bool PerfCounters::open() {
+  if (!_opened) {
+    _opened = true;
+    open_perf_group(_groups[0], perf_core_group, sizeof(perf_core_group) / sizeof(perf_core_group[0]));
+    open_perf_group(_groups[1], perf_cache_group, sizeof(perf_cache_group) / sizeof(perf_cache_group[0]));
+  }
+
+  return is_available();
+}
+
+void PerfCounters::close() {
+  for (Group& group : _groups) {
+    // Members must be closed before the group leader.
+    for (uint32_t i = group.count; i != 0; i--) {
+      ::close(group.fds[i - 1]);
+    }
+    group.count = 0;
+  }
+  _opened = false;
+}
+
+void PerfCounters::start() {
+  for (Group& group : _groups) {
+    if (group.count) {
+      ioctl(group.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(group.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+}
+
+void PerfCounters::stop(PerfCounterValues& out) {
+  out.reset();
+
+  for (Group& group : _groups) {
+    if (group.count)
+      ioctl(group.fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  for (Group& group : _groups) {
+    if (!group.count)
+      continue;
+
+    // Layout defined by PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING.
+    uint64_t data[3 + kPerfCounterKindCount];
+    ssize_t size = read(group.fds[0], data, sizeof(data));
+
+    if (size < ssize_t(sizeof(uint64_t) * 3) || data[0] != group.count)
+      continue;
+
+    uint64_t time_enabled = data[1];
+    uint64_t time_running = data[2];
+
+    // The group was never scheduled (no free PMU counters) - nothing to report.
+    if (!time_running)
+      continue;
+
+    // Scale the values if the group was multiplexed with other groups.
+    double scale = time_running < time_enabled ? double(time_enabled) / double(time_running) : 1.0;
+
+    for (uint32_t i = 0; i < group.count; i++) {
+      uint32_t index = uint32_t(group.kinds[i]);
+      out.values[index] = uint64_t(double(data[3 + i]) * scale);
+      out.valid_mask |= 1u << index;
+    }
+  }
+}
+
+#else
+
+bool PerfCounters::open() { _opened = true; return false; }
+void PerfCounters::close() { _opened = false; }
+void PerfCounters::start() {}
+void PerfCounters::stop(PerfCounterValues& out) { out.reset(); }
+
+#endif // __linux__
+
+bool PerfCounters::is_available() const {
+  return _groups[0].count != 0 || _groups[1].count != 0;
+}
+
+} // {blbench}
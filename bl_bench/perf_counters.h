@@ -0,0 +1,87 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_PERF_COUNTERS_H
+#define BLBENCH_PERF_COUNTERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace blbench {
+
+// blbench::PerfCounterKind
+// ========================
+
+enum class PerfCounterKind : uint32_t {
+  kCycles,
+  kInstructions,
+  kBranchMisses,
+  kStalledCyclesFrontend,
+  kStalledCyclesBackend,
+  kL1DMisses,
+  kLLCMisses,
+
+  kMaxValue = kLLCMisses
+};
+
+static constexpr uint32_t kPerfCounterKindCount = uint32_t(PerfCounterKind::kMaxValue) + 1;
+
+//! Returns a name of the counter as used in JSON output.
+const char* perf_counter_name(PerfCounterKind kind);
+
+// blbench::PerfCounterValues
+// ==========================
+
+//! Values read from hardware performance counters - only counters having a bit set in `valid_mask` are valid.
+struct PerfCounterValues {
+  uint32_t valid_mask;
+  uint64_t values[kPerfCounterKindCount];
+
+  inline void reset() { *this = PerfCounterValues{}; }
+
+  inline bool has(PerfCounterKind kind) const { return (valid_mask & (1u << uint32_t(kind))) != 0; }
+  inline uint64_t get(PerfCounterKind kind) const { return values[uint32_t(kind)]; }
+};
+
+// blbench::PerfCounters
+// =====================
+
+//! Hardware performance counters of the calling thread (Linux `perf_event_open()`).
+//!
+//! Counters are opened in two groups (core and cache events), which are scheduled independently so they fit
+//! into the available PMU counters. Events that cannot be opened (unsupported by the CPU, or not permitted,
+//! which is common in containers) are silently left out and are never reported as valid.
+class PerfCounters {
+public:
+  enum : uint32_t { kGroupCount = 2 };
+
+  struct Group {
+    uint32_t count;
+    int fds[kPerfCounterKindCount];
+    PerfCounterKind kinds[kPerfCounterKindCount];
+  };
+
+  Group _groups[kGroupCount] {};
+  bool _opened = false;
+
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  //! Opens all counters that are available, returns true if at least one is available. Only tries once.
+  bool open();
+  void close();
+
+  bool is_available() const;
+
+  void start();
+  void stop(PerfCounterValues& out);
+};
+
+} // {blbench}
+
+#endif // BLBENCH_PERF_COUNTERS_H
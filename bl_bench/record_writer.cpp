@@ -0,0 +1,58 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "record_writer.h"
+
+#if defined(_WIN32)
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+
+namespace blbench {
+
+RecordWriter::RecordWriter() {}
+RecordWriter::~RecordWriter() { close(); }
+
+bool RecordWriter::open(const char* file_name, bool sync) {
+  close();
+
+  _file = fopen(file_name, "ab");
+  _sync = sync;
+
+  return _file != nullptr;
+}
+
+void RecordWriter::close() {
+  if (_file) {
+    fclose(_file);
+    _file = nullptr;
+  }
+}
+
+static bool sync_file(FILE* file) {
+#if defined(_WIN32)
+  return _commit(_fileno(file)) == 0;
+#else
+  return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool RecordWriter::write_line(const char* data, size_t size) {
+  if (!_file)
+    return false;
+
+  bool ok = fwrite(data, 1, size, _file) == size && fputc('\n', _file) != EOF;
+
+  // Flush after each line so the record is not lost if the process dies before the run finishes.
+  ok &= fflush(_file) == 0;
+
+  if (_sync)
+    ok &= sync_file(_file);
+
+  return ok;
+}
+
+} // {blbench}
@@ -0,0 +1,46 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_RECORD_WRITER_H
+#define BLBENCH_RECORD_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+namespace blbench {
+
+// blbench::RecordWriter
+// =====================
+
+//! Streams test records to a file as newline delimited JSON (NDJSON) - one self-contained JSON object per line.
+//!
+//! Lines are appended and flushed as soon as they are written, thus records of tests that have finished survive
+//! a crash or a timeout of a long run. If `sync` is enabled, the file is also synchronized to the storage after
+//! each line, which survives even a system crash at the cost of a slower write.
+class RecordWriter {
+public:
+  FILE* _file = nullptr;
+  bool _sync = false;
+
+  RecordWriter();
+  ~RecordWriter();
+
+  RecordWriter(const RecordWriter&) = delete;
+  RecordWriter& operator=(const RecordWriter&) = delete;
+
+  //! Opens `file_name` for appending, returns false if the file cannot be opened.
+  bool open(const char* file_name, bool sync);
+  void close();
+
+  inline bool is_open() const { return _file != nullptr; }
+
+  //! Writes a single line (`data` must not contain a line break) followed by '\n'.
+  bool write_line(const char* data, size_t size);
+};
+
+} // {blbench}
+
+#endif // BLBENCH_RECORD_WRITER_H
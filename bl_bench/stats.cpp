@@ -0,0 +1,100 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "stats.h"
+
+#include <blend2d.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace blbench {
+
+static constexpr uint32_t kBootstrapIterations = 1000;
+static constexpr double kBootstrapConfidence = 0.95;
+
+double percentile_of_sorted(const double* samples, size_t count, double p) {
+  if (!count)
+    return 0.0;
+
+  double rank = (p / 100.0) * double(count - 1);
+  size_t lo = size_t(std::floor(rank));
+  size_t hi = std::min(lo + 1, count - 1);
+  double t = rank - double(lo);
+
+  return samples[lo] + (samples[hi] - samples[lo]) * t;
+}
+
+static double median_of(double* samples, size_t count) {
+  size_t mid = count / 2;
+  std::nth_element(samples, samples + mid, samples + count);
+  double m = samples[mid];
+
+  if ((count & 1u) == 0) {
+    double lower = *std::max_element(samples, samples + mid);
+    m = (m + lower) * 0.5;
+  }
+
+  return m;
+}
+
+void bootstrap_median_ci(double& low, double& high, const double* samples, size_t count, double confidence, uint32_t iterations) {
+  if (count < 2) {
+    low = high = count ? samples[0] : 0.0;
+    return;
+  }
+
+  // Fixed seed - the interval must only depend on samples.
+  BLRandom rnd(0x5EEDB007ull);
+
+  std::vector<double> resample(count);
+  std::vector<double> medians(iterations);
+
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (size_t j = 0; j < count; j++) {
+      resample[j] = samples[rnd.next_uint32() % count];
+    }
+    medians[i] = median_of(resample.data(), count);
+  }
+
+  std::sort(medians.begin(), medians.end());
+
+  double tail = (1.0 - confidence) * 0.5 * 100.0;
+  low = percentile_of_sorted(medians.data(), iterations, tail);
+  high = percentile_of_sorted(medians.data(), iterations, 100.0 - tail);
+}
+
+void calculate_sample_stats(SampleStats& out, const double* samples, size_t count) {
+  out = SampleStats{};
+  if (!count)
+    return;
+
+  std::vector<double> sorted(samples, samples + count);
+  std::sort(sorted.begin(), sorted.end());
+
+  double sum = 0.0;
+  for (double v : sorted)
+    sum += v;
+
+  double mean = sum / double(count);
+  double sq = 0.0;
+
+  for (double v : sorted)
+    sq += (v - mean) * (v - mean);
+
+  out.count = uint32_t(count);
+  out.min = sorted.front();
+  out.max = sorted.back();
+  out.mean = mean;
+  out.median = percentile_of_sorted(sorted.data(), count, 50.0);
+  out.p5 = percentile_of_sorted(sorted.data(), count, 5.0);
+  out.p95 = percentile_of_sorted(sorted.data(), count, 95.0);
+  out.stddev = count > 1 ? std::sqrt(sq / double(count - 1)) : 0.0;
+
+  bootstrap_median_ci(out.ci_low, out.ci_high, sorted.data(), count, kBootstrapConfidence, kBootstrapIterations);
+}
+
+} // {blbench}
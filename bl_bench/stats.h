@@ -0,0 +1,56 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_STATS_H
+#define BLBENCH_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace blbench {
+
+// blbench::SampleStats
+// ====================
+
+//! Statistics calculated from all samples collected for a single test configuration.
+//!
+//! All values use the unit of the input samples (bl_bench uses calls per millisecond).
+struct SampleStats {
+  //! Number of samples.
+  uint32_t count;
+
+  double min;
+  double max;
+  double mean;
+  double median;
+  double p5;
+  double p95;
+  double stddev;
+
+  //! Lower bound of the bootstrap confidence interval of the median.
+  double ci_low;
+  //! Upper bound of the bootstrap confidence interval of the median.
+  double ci_high;
+
+  //! Returns the width of the confidence interval relative to the median.
+  inline double ci_relative_width() const {
+    return median > 0.0 ? (ci_high - ci_low) / median : 0.0;
+  }
+};
+
+//! Returns the `p`-th percentile (0..100) of sorted `samples` (linear interpolation between closest ranks).
+double percentile_of_sorted(const double* samples, size_t count, double p);
+
+//! Calculates a bootstrap confidence interval of the median of `samples`.
+//!
+//! Uses a fixed seed, so the same samples always produce the same interval.
+void bootstrap_median_ci(double& low, double& high, const double* samples, size_t count, double confidence, uint32_t iterations);
+
+//! Calculates all statistics of `samples`, including a 95% bootstrap confidence interval of the median.
+void calculate_sample_stats(SampleStats& out, const double* samples, size_t count);
+
+} // {blbench}
+
+#endif // BLBENCH_STATS_H
@@ -0,0 +1,62 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "text_data.h"
+#include "../bl_litehtml/abeezee_regular_ttf.h"
+
+#include <string.h>
+
+namespace blbench {
+
+static const char* const label_lines[] = {
+  "Revenue: 1,234.56"
+};
+
+static const char* const paragraph_lines[] = {
+  "The quick brown fox jumps over the lazy dog and",
+  "keeps running through the quiet summer fields,",
+  "past old farms, narrow rivers and tall forests",
+  "until it finally rests beneath an oak tree."
+};
+
+static const char* const glyph_run_lines[] = {
+  "Mixed 0123456789 AaBbCc (x+y)*z=42; [OK] #7 @home!"
+};
+
+template<size_t N>
+static bool init_text_data(TextData& dst, const char* const (&lines)[N]) {
+  uint32_t glyph_count = 0;
+  for (size_t i = 0; i < N; i++)
+    glyph_count += uint32_t(strlen(lines[i]));
+
+  dst.lines = lines;
+  dst.line_count = N;
+  dst.glyph_count = glyph_count;
+  return true;
+}
+
+bool get_text_data(TextData& dst, TextKind kind) {
+  switch (kind) {
+    case TextKind::kLabel:
+      return init_text_data(dst, label_lines);
+
+    case TextKind::kParagraph:
+      return init_text_data(dst, paragraph_lines);
+
+    case TextKind::kGlyphRun:
+      return init_text_data(dst, glyph_run_lines);
+
+    default:
+      dst = TextData{};
+      return false;
+  }
+}
+
+const uint8_t* get_text_font_data(size_t* size_out) {
+  *size_out = sizeof(resource_abeezee_regular_ttf);
+  return resource_abeezee_regular_ttf;
+}
+
+} // {blbench}
@@ -0,0 +1,43 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLBENCH_TEXT_DATA_H
+#define BLBENCH_TEXT_DATA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace blbench {
+
+enum class TextKind : uint32_t {
+  //! A short label (single line).
+  kLabel,
+  //! A paragraph of several lines.
+  kParagraph,
+  //! A single line of mixed letters, digits, and punctuation that is shaped once and rendered as a glyph run.
+  kGlyphRun,
+
+  kMaxValue = kGlyphRun
+};
+
+//! Distance between baselines of two lines of a paragraph relative to the font size.
+static constexpr double kTextLineHeight = 1.25;
+
+//! Text rendered by text tests - each line is rendered by a separate call.
+struct TextData {
+  const char* const* lines;
+  size_t line_count;
+  //! Glyphs rendered by a single render call (all lines). The text is ASCII, which maps to one glyph per character.
+  uint32_t glyph_count;
+};
+
+bool get_text_data(TextData& dst, TextKind kind);
+
+//! Returns the font used by all text tests (ABeeZee Regular, which is also embedded by bl_litehtml).
+const uint8_t* get_text_font_data(size_t* size_out);
+
+} // {blbench}
+
+#endif // BLBENCH_TEXT_DATA_H